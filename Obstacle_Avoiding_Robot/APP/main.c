@@ -7,6 +7,7 @@
 
 #include "../LIB/STD_TYPES.h"
 #include "../LIB/BIT_MATH.h"
+#include "../LIB/FLASH.h"
 #include "../HAL/LCD/LCD.h"
 #include "../MCAL/DIO/DIO.h"
 #include "../MCAL/TIMER/TIMER.h"
@@ -14,15 +15,85 @@
 #include "../HAL/ULTRASONIC/ULTRASONIC.h"
 #include "../HAL/SERVO/SERVO.h"
 #include "../HAL/CAR/_2_WHEELS/MOVEMENT/MOVEMENT.h"
+#include "../HAL/H_BRIDGE/L293/H_BRIDGE.h"
+#include "../HAL/CAR/_2_WHEELS/ODOMETRY/ODOMETRY.h"
+#include "../HAL/CAR/_2_WHEELS/MOTION/MOTION.h"
+#include "../HAL/CAR/_2_WHEELS/CALIBRATION/CALIBRATION.h"
+#include "../HAL/CAR/_2_WHEELS/BRAKE/BRAKE.h"
+#include "../MCAL/ADC/ADC.h"
+#include "../HAL/CAR/_2_WHEELS/CURRENT/CURRENT.h"
+#include "../MCAL/TIMER/TICK/TICK.h"
+#include "../HAL/DASHBOARD/DASHBOARD.h"
 #include <util/delay.h>
 
 /* Macros Definition */
 #define FORWARD						0
 #define NON_FORWARD					1
 #define OBSTACLE_THRESHOLD_CM_ 		45
+#define OBSTACLE_CLEARANCE_CM_		25				// Space left in front of the car after it stops, so it can rotate.
+#define CALIBRATION_MODE			0				// Set to 1 to measure the motors on start-up and save their speed tables into the EEPROM.
+#define DIO_BENCHMARK				0				// Set to 1 to print the cycles of DIO_SetPinValue() and DIO_FAST_SetPinHigh() on start-up.
+#define DIO_BENCHMARK_CALLS			1000
+#define LCD_BENCHMARK				0				// Set to 1 to print how many characters per second are written to the LCD on start-up.
+#define LCD_BENCHMARK_CHARACTERS	320
+#define DEAD_TIME_TEST				0				// Set to 1 to check on start-up that a reversal waits for the dead time unless it is skipped.
+#define DISTANCE_BAR				1				// Set to 0 to print the distance as a number instead of a bar on the second line.
+#define DISTANCE_BAR_RANGE_CM_		200				// The bar starts growing when an obstacle is closer than this, and is full at 0cm.
+#define ARROW_COLUMN				15
+#define DASHBOARD					0				// Set to 1 to show the diagnostics pages on the LCD instead of the direction and distance.
+#define BOOT_REPORT					0				// Set to 1 to print how long each step of the start-up took, before the car starts.
+#define ELAPSED_MS()				((u16_t) (TIMER_TICK_GetCounts() / (F_CPU / TIMER_TICK_CYCLES_PER_COUNT / 1000UL)))	// Since TIMER_TICK_Init().
 
 /* Variables */
 u8_t direction;
+u8_t reflex_stopped;
+u8_t stall_avoided;										// The stall that the current avoidance pass handles.
+u16_t obstacle_distance_mm;
+volatile u8_t wheel_stalled = 0;						// Set when a wheel is jammed against something the ultrasonic sensor cannot see.
+u16_t boot_lcd_ms = 0;									// LCD is ready.
+u16_t boot_ranging_ms = 0;								// First distance is measured.
+u16_t boot_ready_ms = 0;								// Servo is centered, so the car can start.
+
+/* Texts */
+/*
+ * NOTE:
+ * 		All the texts on the LCD are kept in the program memory and printed with LCD_SendString_P(), so they take no SRAM.
+ * 		Spaces after the shorter directions are written to remove any left characters from "Forward" and "Backward".
+ *
+ */
+const char text_forward[] FLASH_SECTION = "Forward ";
+const char text_backward[] FLASH_SECTION = "Backward";
+const char text_right[] FLASH_SECTION = "Right   ";
+const char text_left[] FLASH_SECTION = "Left    ";
+const char text_stopped[] FLASH_SECTION = "Stopped  ";
+const char text_calibrate[] FLASH_SECTION = "Calibrate";
+const char text_direction[] FLASH_SECTION = "Dir: ";
+const char text_distance[] FLASH_SECTION = "Dist= ";
+const char text_cm[] FLASH_SECTION = "cm";
+const char text_dio_function[] FLASH_SECTION = "DIO fn: ";
+const char text_dio_fast[] FLASH_SECTION = "DIO fast: ";
+const char text_lcd_rate[] FLASH_SECTION = "LCD chars/s: ";
+const char text_dead_time[] FLASH_SECTION = "Dead time: ";
+const char text_passed[] FLASH_SECTION = "OK";
+const char text_failed[] FLASH_SECTION = "FAIL";
+const char text_boot_lcd[] FLASH_SECTION = "LCD ";
+const char text_boot_ranging[] FLASH_SECTION = " Ping ";
+const char text_boot_ready[] FLASH_SECTION = "Drive ";
+const char text_ms[] FLASH_SECTION = " ms";
+
+const char* const direction_texts[] FLASH_SECTION = {			// Indexed by CAR_directions.
+	text_forward,
+	text_backward,
+	text_right,
+	text_left
+};
+
+const u8_t direction_arrows[] FLASH_SECTION = {				// Indexed by CAR_directions.
+	LCD_GLYPH_ARROW_UP,
+	LCD_GLYPH_ARROW_DOWN,
+	LCD_ARROW_RIGHT,
+	LCD_ARROW_LEFT
+};
 
 
 /********************************\
@@ -30,78 +101,251 @@ u8_t direction;
 \********************************/
 
 void PrintDirection(CAR_directions direction){
+	if (DASHBOARD){
+		return;															// The LCD buffer is written by the dashboard from the tick.
+	}
 	LCD_GoToPosition(UPPER_ROW,5);
-	switch (direction){
-	case CAR_FORWARD:
-		LCD_SendString("Forward");
-		break;
-	case CAR_BACKWARD:
-		LCD_SendString("Backward");
-		break;
-	case CAR_RIGHT:
-		LCD_SendString("Right   ");
-		break;
-	case CAR_LEFT:
-		LCD_SendString("Left    ");
-		break;
-	}
-	/*
-	 * NOTE:
-	 * 		Spaces after "Right" and "Left" are written to remove any left characters from "Forward" and "Backward" if existed.
-	 *
-	 */
+	LCD_SendString_P((const char*) FLASH_ReadWord(&direction_texts[direction]));	// The table itself is in the flash too.
+	LCD_GoToPosition(UPPER_ROW, ARROW_COLUMN);
+	LCD_SendChar(FLASH_ReadByte(&direction_arrows[direction]));
+	LCD_Flush();
 }
 
-void PrintDistance(void){
-	LCD_GoToPosition(LOWER_ROW, 6);
-	LCD_SendNumber((u16_t) ULTRASONIC_GetDistance_cm_());
-	if (ULTRASONIC_GetDistance_cm_() < 10){			// 1-digit distance
-		LCD_GoToPosition(LOWER_ROW, 7);
-		LCD_SendString("  ");						// Write 2 spaces after the distance to remove the last 2 digits from a past distance if existed.
+void StallHandler(void){
+	CAR_MOVEMENT_StallHandler();										// Cut the duty of the motors.
+	wheel_stalled = 1;													// Avoid the obstacle as if it was seen in front of the car.
+}
+
+void ReflexHandler(void){
+	CAR_BRAKE_Stop();													// Brake at once from the echo interrupt, without waiting for the loop.
+}
+
+void BenchmarkDio(void){
+	u16_t i;
+	u32_t start;
+	u32_t function_counts;
+	u32_t fast_counts;
+	// The TRIG pin is toggled, since a short pulse on it only starts a measurement that is ignored.
+	start = TIMER_TICK_GetCounts();
+	for (i = 0; i < DIO_BENCHMARK_CALLS; i++){
+		DIO_SetPinValue(ULTRASONIC_PORT, TRIG, PIN_HIGH);
+		DIO_SetPinValue(ULTRASONIC_PORT, TRIG, PIN_LOW);
+	}
+	function_counts = TIMER_TICK_GetCounts() - start;
+	start = TIMER_TICK_GetCounts();
+	for (i = 0; i < DIO_BENCHMARK_CALLS; i++){
+		DIO_FAST_SetPinHigh(ULTRASONIC_PORT, TRIG);
+		DIO_FAST_SetPinLow(ULTRASONIC_PORT, TRIG);
 	}
-	else if (ULTRASONIC_GetDistance_cm_() < 100){	// 2-digits distance
-		LCD_GoToPosition(LOWER_ROW, 8);
-		LCD_SendChar(' ');							// Write one space after the distance to remove the last digit from a past distance if existed.
+	fast_counts = TIMER_TICK_GetCounts() - start;
+	// Each count is 64 cycles, and each loop makes two calls. The loop itself is included in both numbers.
+	LCD_Clear();
+	LCD_SendString_P(text_dio_function);
+	LCD_SendNumber(function_counts * TIMER_TICK_CYCLES_PER_COUNT / (2 * DIO_BENCHMARK_CALLS));
+	LCD_GoToPosition(LOWER_ROW, 0);
+	LCD_SendString_P(text_dio_fast);
+	LCD_SendNumber(fast_counts * TIMER_TICK_CYCLES_PER_COUNT / (2 * DIO_BENCHMARK_CALLS));
+	LCD_Flush();
+	_delay_ms(3000);
+}
+
+void BenchmarkLcd(void){
+	u16_t i;
+	u32_t start;
+	u32_t counts;
+	LCD_SetDDRAMAddress(0);
+	start = TIMER_TICK_GetCounts();
+	for (i = 0; i < LCD_BENCHMARK_CHARACTERS; i++){
+		if (i % LCD_COLUMNS == 0){
+			LCD_SetDDRAMAddress(0);						// Stay in the visible part of the first row, like a real update.
+		}
+		LCD_WriteData('0' + i % 10);
 	}
+	counts = TIMER_TICK_GetCounts() - start;
+	LCD_Init(_4bits);												// The characters were written around the buffer, so both are cleared again.
+	LCD_SendString_P(text_lcd_rate);
+	LCD_GoToPosition(LOWER_ROW, 0);
+	LCD_SendNumber((u32_t) LCD_BENCHMARK_CHARACTERS * (F_CPU / TIMER_TICK_CYCLES_PER_COUNT) / counts);
+	LCD_Flush();
+	_delay_ms(3000);
 }
 
-int main(){
-	INTERRUPT_EnableGlobalInterrupt();
-	LCD_Init(_4bits);													// Initialize LCD as 4-bits.
-	LCD_SendString("Dir: ");											// To indicate the directory.
+u8_t TestDeadTime(void){
+	u8_t passed;
+	// Motor 1 is driven CW, then reversed at once, which must be turned into a fast stop (both A pins low).
+	H_BRIDGE_L293_Motor_CW(H_EN1, H_A1, H_A2);
+	H_BRIDGE_L293_Motor_CCW(H_EN1, H_A1, H_A2);
+	passed = !DIO_GetPinValue(H_bridge_A_PORT, H_A1) && !DIO_GetPinValue(H_bridge_A_PORT, H_A2);
+	// After the skip, the same reversal must drive the motor CCW (A1 high, A2 low), as the reverse braking pulse does.
+	H_BRIDGE_L293_SkipDeadTime();
+	H_BRIDGE_L293_Motor_CCW(H_EN1, H_A1, H_A2);
+	passed = passed && DIO_GetPinValue(H_bridge_A_PORT, H_A1) && !DIO_GetPinValue(H_bridge_A_PORT, H_A2);
+	H_BRIDGE_L293_Motor_FreeStop(H_EN1);
+	H_BRIDGE_L293_SkipDeadTime();									// The car starts with no dead time left from the test.
+	LCD_Clear();
+	LCD_SendString_P(text_dead_time);
+	LCD_SendString_P(passed ? text_passed : text_failed);
+	LCD_Flush();
+	_delay_ms(3000);
+	return passed;
+}
+
+void PrintLabels(void){
+	LCD_SendString_P(text_direction);									// To indicate the directory.
+
+	// Write "Dist=    cm" in the second line of LCD, unless the whole line is used by the bar.
+	if (!DISTANCE_BAR){
+		LCD_GoToPosition(LOWER_ROW, 0);
+		LCD_SendString_P(text_distance);
+		LCD_GoToPosition(LOWER_ROW, 9);
+		LCD_SendString_P(text_cm);
+	}
+	LCD_Flush();
+}
 
-	// Write "Dist=    cm" in the second line of LCD.
+void ReportBoot(void){
+	// The time before main() (start-up delay of the fuses and the C start-up code) is not included.
+	LCD_Clear();
+	LCD_SendString_P(text_boot_lcd);
+	LCD_SendU16(boot_lcd_ms);
+	LCD_SendString_P(text_boot_ranging);
+	LCD_SendU16(boot_ranging_ms);
 	LCD_GoToPosition(LOWER_ROW, 0);
-	LCD_SendString("Dist= ");
-	LCD_GoToPosition(LOWER_ROW, 9);
-	LCD_SendString("cm");
+	LCD_SendString_P(text_boot_ready);
+	LCD_SendU16(boot_ready_ms);
+	LCD_SendString_P(text_ms);
+	LCD_Flush();
+	_delay_ms(3000);
+	LCD_Clear();
+	PrintLabels();
+}
 
+void PrintDistance(void){
+	u16_t distance = (u16_t) ULTRASONIC_GetDistance_cm_();
+	if (DASHBOARD){
+		return;
+	}
+	if (DISTANCE_BAR){
+		// The closer the obstacle, the longer the bar, so it can be read at a glance while the car moves.
+		LCD_GoToPosition(LOWER_ROW, 0);
+		LCD_SendBar(LCD_COLUMNS, (distance < DISTANCE_BAR_RANGE_CM_) ? DISTANCE_BAR_RANGE_CM_ - distance : 0, DISTANCE_BAR_RANGE_CM_);
+	}
+	else{
+		LCD_GoToPosition(LOWER_ROW, 6);
+		LCD_SendU16Padded(distance, 3);				// Up to 400cm, padded with spaces so no digits of a past distance are left.
+	}
+	LCD_Flush();									// Only the cells that changed are sent to the LCD.
+}
+
+int main(){
+	if (DASHBOARD){
+		DASHBOARD_PaintStack();											// Before the stack goes any deeper, to measure how deep it goes.
+	}
+	INTERRUPT_EnableGlobalInterrupt();
+	TIMER_TICK_Init();													// First, so the start-up is timed from here and the LCD power-on time passes during the next steps.
+	SERVO_StartCenter();												// The servo is centered in the background, so the distance is measured at once.
 	CAR_MOVEMENT_Motors_Init(CAR_DC_MOTORS_DIFFERENT_SPEEDS);			// Both motors are working with the same speed.
 	CAR_MOVEMENT_DifferentSpeeds_SetDefaultSpeedPercentages(54,50);		// Motors speed are 54, 50%.
+	CAR_CALIBRATION_Load();												// If the motors were calibrated, both run at 52% of the same speed instead.
+	CAR_ODOMETRY_Init(CAR_ODOMETRY_COMMANDED_SPEED);					// No encoders are fitted, so the pose is estimated from the motors speed.
+	CAR_MOTION_Init();													// Motion primitives can be queued to run from the timer tick.
+	CAR_BRAKE_Init();
+	CAR_CURRENT_Init();													// Monitor the motors current in the background.
+	CAR_CURRENT_SetStallCallBack(StallHandler);
 	ULTRASONIC_Init();
-	SERVO_Center();														// Ensure the servo motor is centered.
+	ULTRASONIC_Reflex_SetCallBack(ReflexHandler);
+	LCD_Init(_4bits);													// Initialize LCD as 4-bits (it waits only for what is left of its power-on time).
+	boot_lcd_ms = ELAPSED_MS();
+	if (DIO_BENCHMARK){
+		BenchmarkDio();													// The TRIG pin is used for the benchmark, and the tick for timing.
+		LCD_Clear();
+	}
+	if (LCD_BENCHMARK){
+		BenchmarkLcd();
+		LCD_Clear();
+	}
+	if (DEAD_TIME_TEST){
+		TestDeadTime();													// The motors are driven only for a few microseconds.
+		LCD_Clear();
+	}
+	PrintLabels();
+	LCD_StartBackgroundRefresh();										// From now on, the screen is sent from the tick, so LCD_Flush() returns at once.
+	if (DASHBOARD){
+		DASHBOARD_Init(DASHBOARD_AUTO_CYCLE);							// The pages change every 3 seconds, or at once with the button on INT0.
+	}
+	if (CALIBRATION_MODE && !DASHBOARD){
+		LCD_GoToPosition(UPPER_ROW,5);
+		LCD_SendString_P(text_calibrate);
+		LCD_Flush();
+	}
+	if (CALIBRATION_MODE){
+		while (SERVO_IsMoving());										// The motors need Timer1, which the servo is still using.
+		CAR_CALIBRATION_CharacterizePwm(CAR_CALIBRATION_ULTRASONIC, NULL);	// Select the PWM frequency that matches the motors best.
+		CAR_CALIBRATION_Run(CAR_CALIBRATION_ULTRASONIC);				// No encoders are fitted, so the walls around the car are used.
+	}
 	direction = NON_FORWARD;
 	while(1){
+		if (DASHBOARD){
+			DASHBOARD_CountLoop();										// For the loop rate on the dashboard.
+			DASHBOARD_MeasureStack();
+		}
 		ULTRASONIC_TRIG_Send();											// Send an ultrasonic trigger (with a delay inside to wait the echo).
+		if (!boot_ranging_ms){
+			boot_ranging_ms = ELAPSED_MS();
+		}
 		PrintDistance();												// Print distance on LCD after the echo gets a response.
-		if (ULTRASONIC_GetDistance_cm_() > OBSTACLE_THRESHOLD_CM_){
+		if (SERVO_IsMoving()){
+			continue;													// The servo still uses Timer1, so the car starts when it is centered.
+		}
+		if (!boot_ready_ms){
+			boot_ready_ms = ELAPSED_MS();
+			if (BOOT_REPORT && !DASHBOARD){
+				ReportBoot();
+			}
+		}
+		// The car is stopped only when the obstacle is as close as the distance it needs to stop plus the clearance.
+		// Once the reflex has braked, the commands are 0 and so is the stopping distance, so the avoidance must follow anyway.
+		if (!wheel_stalled && !ULTRASONIC_Reflex_IsTriggered() && ULTRASONIC_GetDistance_cm_() > OBSTACLE_CLEARANCE_CM_ + (CAR_BRAKE_GetStoppingDistance_mm_(CAR_BRAKE_GetSpeed()) + 9) / 10){
 
 			// Checking if direction was not set as forward, to call the next lines when only needed.
 			if (direction != FORWARD){
 				PrintDirection(CAR_FORWARD);							// Print the direction as "Forward".
 				CAR_MOVEMENT_Forward();									// Move the car in forward direction.
 				direction = FORWARD;									// Change the direction to be forward to avoid calling the previous 2 function again.
+				// The same distance that the loop checks is checked by the echo interrupt, so the car stops without the loop delays.
+				ULTRASONIC_Reflex_Arm(OBSTACLE_CLEARANCE_CM_ + (CAR_BRAKE_GetStoppingDistance_mm_(CAR_BRAKE_GetSpeed()) + 9) / 10);
 			}
 
 			_delay_ms(100);
 			continue;													// Skip the rest of the code and enter the loop again.
 		}
 
-		// If the distance read from the front of the car is less than 45, ...
-		CAR_MOVEMENT_Stop();
+		// If the obstacle in front of the car is closer than that, ...
+		obstacle_distance_mm = (u16_t) (ultrasonic_distance * 10);
+		reflex_stopped = ULTRASONIC_Reflex_IsTriggered();
+		// The stall is taken here, so one that happens during the turns below is still set for the next pass.
+		INTERRUPT_DisableGlobalInterrupt();
+		stall_avoided = wheel_stalled;
+		wheel_stalled = 0;
+		INTERRUPT_EnableGlobalInterrupt();
+		if (!reflex_stopped){
+			ULTRASONIC_Reflex_Disarm();									// The servo turns next, so the echoes are not from the front anymore.
+			CAR_BRAKE_Stop();											// Brake according to the speed of the car.
+		}
+		if (direction == FORWARD && !stall_avoided){
+			while (CAR_BRAKE_IsBraking());
+			_delay_ms(200);												// Wait for the car to come to rest.
+			ULTRASONIC_TRIG_Send();
+			CAR_BRAKE_Learn(obstacle_distance_mm, (u16_t) (ultrasonic_distance * 10));	// Measure how far the car moved to stop.
+		}
 		direction = NON_FORWARD;										// Change the direction to be non-forward.
-		LCD_GoToPosition(UPPER_ROW,5);
-		LCD_SendString("Stopped  ");									// Print the direction as "Stopped".
+		if (!DASHBOARD){
+			LCD_GoToPosition(UPPER_ROW,5);
+			LCD_SendString_P(text_stopped);								// Print the direction as "Stopped".
+			LCD_GoToPosition(UPPER_ROW, ARROW_COLUMN);
+			LCD_SendChar(LCD_GLYPH_STOP);
+			LCD_Flush();
+		}
 		SERVO_90_CW();													// Rotate the servo motor into the right of the car.
 		ULTRASONIC_TRIG_Send();											// Send an ultrasonic trigger (with a delay inside to wait the echo).
 		PrintDistance();												// Print the distance on LCD.
@@ -127,6 +371,7 @@ int main(){
 			}
 		}
 		CAR_MOVEMENT_Stop();											// Stop the car.
+		ULTRASONIC_Reflex_Disarm();										// The reflex that started this avoidance is handled now.
 		SERVO_Center();													// Center the servo motor.
 	}
 }
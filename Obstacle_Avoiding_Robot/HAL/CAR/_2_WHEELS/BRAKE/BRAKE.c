@@ -0,0 +1,120 @@
+/*
+ * BRAKE.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../../../LIB/STD_TYPES.h"
+#include "../../../../LIB/BIT_MATH.h"
+#include "../../../../MCAL/DIO/DIO.h"
+#include "../../../../MCAL/TIMER/TICK/TICK.h"
+#include "../../../H_BRIDGE/L293/H_BRIDGE.h"
+#include "../../../ULTRASONIC/ULTRASONIC.h"
+#include "../MOVEMENT/MOVEMENT.h"
+#include "BRAKE.h"
+
+/* Variables */
+volatile u8_t brake_pulse_ticks = 0;			// Ticks left in the reverse pulse, 0 if no pulse is running.
+u8_t brake_last_bucket = 0;
+u16_t brake_stopping_distances[CAR_BRAKE_SPEED_BUCKETS] = {10, 30, 60, 100, 150};	// mm, safe estimates until they are measured.
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void CAR_BRAKE_Init(void){
+	TIMER_TICK_Init();
+	TIMER_TICK_AddCallBack(CAR_BRAKE_Update);
+}
+
+CAR_brake_strategy CAR_BRAKE_Stop(void){
+	s8_t motor1_speed = CAR_MOVEMENT_Motor1_GetSpeed();
+	s8_t motor2_speed = CAR_MOVEMENT_Motor2_GetSpeed();
+	u8_t speed = CAR_BRAKE_GetSpeed();
+	CAR_brake_strategy strategy = CAR_BRAKE_SelectStrategy(speed);
+	brake_last_bucket = (speed / CAR_BRAKE_BUCKET_WIDTH < CAR_BRAKE_SPEED_BUCKETS) ? speed / CAR_BRAKE_BUCKET_WIDTH : CAR_BRAKE_SPEED_BUCKETS - 1;
+	CAR_MOVEMENT_Stop();					// Stops the PWM timers and shorts the motors (active brake).
+	switch (strategy){
+	case CAR_BRAKE_COAST:
+		H_BRIDGE_L293_SetBoth(H_BRIDGE_FREE_STOP, H_BRIDGE_FREE_STOP);
+		break;
+	case CAR_BRAKE_REVERSE_PULSE:
+		// Each motor is driven against the direction it was moving in, at full speed.
+		H_BRIDGE_L293_SkipDeadTime();		// This reversal is meant, and it is short.
+		if (motor1_speed > 0){
+			CAR_MOVEMENT_Motor1_Backward_FullSpeed();
+		}
+		else if (motor1_speed < 0){
+			CAR_MOVEMENT_Motor1_Forward_FullSpeed();
+		}
+		if (motor2_speed > 0){
+			CAR_MOVEMENT_Motor2_Backward_FullSpeed();
+		}
+		else if (motor2_speed < 0){
+			CAR_MOVEMENT_Motor2_Forward_FullSpeed();
+		}
+		brake_pulse_ticks = TIMER_TICK_MS_TO_TICKS(CAR_BRAKE_REVERSE_PULSE_MS_);
+		break;
+	default:
+		break;
+	}
+	return strategy;
+}
+
+CAR_brake_strategy CAR_BRAKE_SelectStrategy(u8_t speed){
+	if (speed <= CAR_BRAKE_COAST_MAXIMUM_SPEED){
+		return CAR_BRAKE_COAST;
+	}
+	if (speed >= CAR_BRAKE_REVERSE_MINIMUM_SPEED){
+		return CAR_BRAKE_REVERSE_PULSE;
+	}
+	return CAR_BRAKE_ACTIVE;
+}
+
+u8_t CAR_BRAKE_GetSpeed(void){
+	s8_t motor1_speed = CAR_MOVEMENT_Motor1_GetSpeed();
+	s8_t motor2_speed = CAR_MOVEMENT_Motor2_GetSpeed();
+	if (motor1_speed < 0){
+		motor1_speed = -motor1_speed;
+	}
+	if (motor2_speed < 0){
+		motor2_speed = -motor2_speed;
+	}
+	return (motor1_speed > motor2_speed) ? motor1_speed : motor2_speed;
+}
+
+u8_t CAR_BRAKE_IsBraking(void){
+	return (brake_pulse_ticks != 0);
+}
+
+void CAR_BRAKE_Learn(u16_t distance_before_mm, u16_t distance_after_mm){
+	s16_t measured;
+	s16_t error;
+	if (distance_before_mm == 0 || distance_before_mm >= CAR_BRAKE_MAXIMUM_DISTANCE_MM_ ||
+		distance_after_mm == 0 || distance_after_mm >= CAR_BRAKE_MAXIMUM_DISTANCE_MM_){
+		return;			// A timeout would be learned as a stopping distance of 0 or of meters.
+	}
+	measured = (distance_before_mm > distance_after_mm) ? distance_before_mm - distance_after_mm : 0;
+	error = measured - (s16_t) brake_stopping_distances[brake_last_bucket];
+	brake_stopping_distances[brake_last_bucket] += error / (1 << CAR_BRAKE_LEARNING_SHIFT);
+}
+
+u16_t CAR_BRAKE_GetStoppingDistance_mm_(u8_t speed){
+	u8_t bucket = speed / CAR_BRAKE_BUCKET_WIDTH;
+	if (bucket >= CAR_BRAKE_SPEED_BUCKETS){
+		bucket = CAR_BRAKE_SPEED_BUCKETS - 1;
+	}
+	return brake_stopping_distances[bucket];
+}
+
+void CAR_BRAKE_Update(void){
+	if (brake_pulse_ticks == 0){
+		return;
+	}
+	brake_pulse_ticks--;
+	if (brake_pulse_ticks == 0 && CAR_MOVEMENT_Motor1_GetSpeed() == 0 && CAR_MOVEMENT_Motor2_GetSpeed() == 0){
+		CAR_MOVEMENT_Low();
+	}
+}
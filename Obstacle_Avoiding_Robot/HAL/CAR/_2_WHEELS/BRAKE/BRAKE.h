@@ -0,0 +1,134 @@
+/*
+ * BRAKE.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef HAL_CAR_BRAKE_BRAKE_H_
+#define HAL_CAR_BRAKE_BRAKE_H_
+
+/* Strategy Thresholds */
+/*
+ * NOTE:
+ * 		- At low speeds the car stops in a few millimeters anyway, so it coasts to avoid jerking the servo and the sensor.
+ * 		- At high speeds a short full reverse pulse removes most of the momentum before shorting the motors.
+ * 		- Speeds are percentages as returned by CAR_MOVEMENT_Motor1_GetSpeed() and CAR_MOVEMENT_Motor2_GetSpeed().
+ *
+ */
+#define CAR_BRAKE_COAST_MAXIMUM_SPEED		20		// Coast at this speed and below.
+#define CAR_BRAKE_REVERSE_MINIMUM_SPEED		70		// Reverse pulse at this speed and above, active brake in between.
+#define CAR_BRAKE_REVERSE_PULSE_MS_			40
+
+/* Stopping Distance Table */
+#define CAR_BRAKE_SPEED_BUCKETS				5		// 0-19%, 20-39%, 40-59%, 60-79% and 80-100%.
+#define CAR_BRAKE_BUCKET_WIDTH				20
+#define CAR_BRAKE_LEARNING_SHIFT			2		// Each new measurement moves the table by 1/4 of the error.
+#define CAR_BRAKE_MAXIMUM_DISTANCE_MM_		(ULTRASONIC_MAXIMUM_LENGTH_CM_ * 10)	// Readings of 0 or this far are timeouts, so they are not learned.
+
+/* Strategies */
+typedef enum{
+	CAR_BRAKE_COAST,			// Disable the motors and let them spin down.
+	CAR_BRAKE_ACTIVE,			// Short the motors (fast stop).
+	CAR_BRAKE_REVERSE_PULSE		// Drive the motors backward for a short time, then short them.
+} CAR_brake_strategy;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void CAR_BRAKE_Init(void);
+CAR_brake_strategy CAR_BRAKE_Stop(void);
+CAR_brake_strategy CAR_BRAKE_SelectStrategy(u8_t speed);
+u8_t CAR_BRAKE_GetSpeed(void);
+u8_t CAR_BRAKE_IsBraking(void);
+void CAR_BRAKE_Learn(u16_t distance_before_mm, u16_t distance_after_mm);
+u16_t CAR_BRAKE_GetStoppingDistance_mm_(u8_t speed);
+void CAR_BRAKE_Update(void);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	CAR_BRAKE_Init(void):
+ * 				@brief	Initialize the braking service.
+ *
+ * 				@details
+ * 						- Registers CAR_BRAKE_Update() as a tick callback to time the reverse pulse.
+ * 						- The stopping distance table starts with safe estimates and is corrected by CAR_BRAKE_Learn().
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_BRAKE_Stop(void):
+ * 				@brief	Stop the car with the strategy that suits its current speed.
+ *
+ * 				@details
+ * 						- Returns immediately; the reverse pulse is ended by the timer tick.
+ * 						- The speed is remembered, so the next CAR_BRAKE_Learn() updates the right entry of the table.
+ *
+ * 				@return CAR_brake_strategy that was used.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_BRAKE_SelectStrategy(u8_t speed):
+ * 				@brief	Choose the braking strategy for a speed.
+ *
+ * 				@param speed: Speed percentage (0 to 100%).
+ *
+ * 				@return CAR_brake_strategy
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_BRAKE_GetSpeed(void):
+ * 				@brief	Get the speed percentage of the faster motor in any direction.
+ *
+ * 				@return u8_t (0 to 100%).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_BRAKE_IsBraking(void):
+ * 				@brief	Check if a reverse pulse is still running.
+ *
+ * 				@return 1 if braking, 0 otherwise.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_BRAKE_Learn(u16_t distance_before_mm, u16_t distance_after_mm):
+ * 				@brief	Correct the stopping distance of the last CAR_BRAKE_Stop() with a measurement.
+ *
+ * 				@details
+ * 						- The distances are to an obstacle in front of the car (e.g. from the ultrasonic sensor).
+ * 						- distance_before_mm is the reading that made the application stop, so the learned distance also
+ * 						  covers the time between the reading and the stop.
+ * 						- distance_after_mm must be taken after the car has completely stopped.
+ * 						- The table is smoothed by an exponential moving average.
+ * 						- Nothing is learned if either distance is 0 or at least CAR_BRAKE_MAXIMUM_DISTANCE_MM_ (a timeout or no echo).
+ *
+ * 				@param distance_before_mm: Distance to the obstacle before braking.
+ * 				@param distance_after_mm: Distance to the obstacle after stopping.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_BRAKE_GetStoppingDistance_mm_(u8_t speed):
+ * 				@brief	Get the distance that the car needs to stop from a speed.
+ *
+ * 				@param speed: Speed percentage (0 to 100%).
+ *
+ * 				@return u16_t distance in mm.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_BRAKE_Update(void):
+ * 				@brief	End the reverse pulse when its time is over (Tick callback).
+ *
+ * 				@details
+ * 						- If the application drove the car again during the pulse, the motors are left as they are.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* HAL_CAR_BRAKE_BRAKE_H_ */
@@ -0,0 +1,222 @@
+/*
+ * CALIBRATION.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../../../LIB/STD_TYPES.h"
+#include "../../../../LIB/BIT_MATH.h"
+#include "../../../../MCAL/TIMER/TICK/TICK.h"
+#include "../../../../MCAL/EEPROM/EEPROM.h"
+#include "../../../ULTRASONIC/ULTRASONIC.h"
+#include "../../../SERVO/SERVO.h"
+#include "../MOVEMENT/MOVEMENT.h"
+#include "../ODOMETRY/ODOMETRY.h"
+#include "CALIBRATION.h"
+
+/* Variables */
+CAR_calibration_data calibration_data;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+u8_t CAR_CALIBRATION_Run(CAR_calibration_source source){
+	u8_t i;
+	if (CAR_MOVEMENT_GetSpeedMode() != CAR_DC_MOTORS_DIFFERENT_SPEEDS){
+		return 0;
+	}
+	CAR_MOVEMENT_SetSpeedTables(NULL, NULL);			// The raw duty cycles are measured, so the old tables must not be applied.
+	CAR_MOVEMENT_SetDeadBands(0, 0);					// The measured tables include the dead band.
+	TIMER_TICK_Init();
+	calibration_data.motor1_speeds[0] = 0;
+	calibration_data.motor2_speeds[0] = 0;
+	for (i = 1; i < CAR_SPEED_TABLE_POINTS; i++){
+		if (source == CAR_CALIBRATION_ENCODERS){
+			CAR_CALIBRATION_MeasureByEncoders(i * CAR_SPEED_TABLE_STEP, &calibration_data.motor1_speeds[i], &calibration_data.motor2_speeds[i]);
+		}
+		else{
+			CAR_CALIBRATION_MeasureByUltrasonic(i * CAR_SPEED_TABLE_STEP, &calibration_data.motor1_speeds[i], &calibration_data.motor2_speeds[i]);
+		}
+		if (calibration_data.motor1_speeds[i] < calibration_data.motor1_speeds[i - 1]){
+			calibration_data.motor1_speeds[i] = calibration_data.motor1_speeds[i - 1];
+		}
+		if (calibration_data.motor2_speeds[i] < calibration_data.motor2_speeds[i - 1]){
+			calibration_data.motor2_speeds[i] = calibration_data.motor2_speeds[i - 1];
+		}
+	}
+	if (calibration_data.motor1_speeds[CAR_SPEED_TABLE_POINTS - 1] == 0 || calibration_data.motor2_speeds[CAR_SPEED_TABLE_POINTS - 1] == 0){
+		return 0;
+	}
+	calibration_data.magic = CAR_CALIBRATION_MAGIC;
+	calibration_data.version = CAR_CALIBRATION_VERSION;
+	calibration_data.pwm_frequency = CAR_MOVEMENT_GetPwmFrequency();
+	calibration_data.checksum = CAR_CALIBRATION_Checksum();
+	CAR_CALIBRATION_Save();
+	CAR_MOVEMENT_SetSpeedTables(calibration_data.motor1_speeds, calibration_data.motor2_speeds);
+	return 1;
+}
+
+CAR_pwm_frequency CAR_CALIBRATION_CharacterizePwm(CAR_calibration_source source, CAR_pwm_response* responses){
+	CAR_pwm_response response;
+	u8_t frequency;
+	u8_t i;
+	u32_t total;
+	u32_t difference;
+	u32_t best_matched_total = 0;
+	u16_t least_mismatch = 0xFFFF;
+	CAR_pwm_frequency best_matched = CAR_PWM_FREQUENCIES;
+	CAR_pwm_frequency least_mismatched = CAR_MOVEMENT_GetPwmFrequency();
+	if (CAR_MOVEMENT_GetSpeedMode() != CAR_DC_MOTORS_DIFFERENT_SPEEDS){
+		return least_mismatched;
+	}
+	CAR_MOVEMENT_SetSpeedTables(NULL, NULL);
+	CAR_MOVEMENT_SetDeadBands(0, 0);
+	TIMER_TICK_Init();
+	for (frequency = 0; frequency < CAR_PWM_FREQUENCIES; frequency++){
+		CAR_MOVEMENT_SetPwmFrequency(frequency);
+		total = 0;
+		difference = 0;
+		for (i = 0; i < CAR_CALIBRATION_PWM_DUTIES; i++){
+			if (source == CAR_CALIBRATION_ENCODERS){
+				CAR_CALIBRATION_MeasureByEncoders(CAR_CALIBRATION_PWM_FIRST_DUTY + i * CAR_CALIBRATION_PWM_DUTY_STEP, &response.motor1_speeds[i], &response.motor2_speeds[i]);
+			}
+			else{
+				CAR_CALIBRATION_MeasureByUltrasonic(CAR_CALIBRATION_PWM_FIRST_DUTY + i * CAR_CALIBRATION_PWM_DUTY_STEP, &response.motor1_speeds[i], &response.motor2_speeds[i]);
+			}
+			total += response.motor1_speeds[i] + response.motor2_speeds[i];
+			difference += (response.motor1_speeds[i] > response.motor2_speeds[i]) ? response.motor1_speeds[i] - response.motor2_speeds[i] : response.motor2_speeds[i] - response.motor1_speeds[i];
+		}
+		// The difference is compared with the mean speed of one motor, which is half the total.
+		response.mismatch = (total == 0) ? 0xFFFF : (u16_t) (difference * 2000 / total);
+		if (responses){
+			responses[frequency] = response;
+		}
+		if (response.mismatch <= CAR_CALIBRATION_PWM_MISMATCH_PERMILLE && total > best_matched_total){
+			best_matched_total = total;
+			best_matched = frequency;
+		}
+		if (response.mismatch < least_mismatch){
+			least_mismatch = response.mismatch;
+			least_mismatched = frequency;
+		}
+	}
+	CAR_MOVEMENT_SetPwmFrequency((best_matched != CAR_PWM_FREQUENCIES) ? best_matched : least_mismatched);
+	return CAR_MOVEMENT_GetPwmFrequency();
+}
+
+u8_t CAR_CALIBRATION_Load(void){
+	EEPROM_ReadBlock(CAR_CALIBRATION_EEPROM_ADDRESS, &calibration_data, sizeof(calibration_data));
+	if (calibration_data.magic != CAR_CALIBRATION_MAGIC || calibration_data.version != CAR_CALIBRATION_VERSION || calibration_data.checksum != CAR_CALIBRATION_Checksum()){
+		return 0;
+	}
+	CAR_MOVEMENT_SetPwmFrequency(calibration_data.pwm_frequency);
+	CAR_MOVEMENT_SetSpeedTables(calibration_data.motor1_speeds, calibration_data.motor2_speeds);
+	return 1;
+}
+
+void CAR_CALIBRATION_Save(void){
+	EEPROM_WriteBlock(CAR_CALIBRATION_EEPROM_ADDRESS, &calibration_data, sizeof(calibration_data));
+}
+
+void CAR_CALIBRATION_Clear(void){
+	CAR_MOVEMENT_SetSpeedTables(NULL, NULL);
+	EEPROM_WriteByte(CAR_CALIBRATION_EEPROM_ADDRESS, 0xFF);		// An erased magic byte is enough to make the data invalid.
+}
+
+u8_t CAR_CALIBRATION_Checksum(void){
+	const u8_t* bytes = (const u8_t*) &calibration_data;
+	u8_t sum = 0;
+	u8_t i;
+	for (i = 0; i < sizeof(calibration_data) - 1; i++){
+		sum += bytes[i];
+	}
+	return sum;
+}
+
+void CAR_CALIBRATION_MeasureByEncoders(u8_t duty, u16_t* motor1_speed, u16_t* motor2_speed){
+	u16_t motor1_counts;
+	u16_t motor2_counts;
+	u32_t start_tick;
+	u32_t ticks;
+	CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_FORWARD, duty, duty);
+	CAR_CALIBRATION_Wait(TIMER_TICK_MS_TO_TICKS(CAR_CALIBRATION_SETTLE_TIME_MS_));
+	motor1_counts = CAR_ODOMETRY_Motor1_GetTotalCounts();
+	motor2_counts = CAR_ODOMETRY_Motor2_GetTotalCounts();
+	start_tick = TIMER_TICK_GetTicks();
+	CAR_CALIBRATION_Wait(TIMER_TICK_MS_TO_TICKS(CAR_CALIBRATION_RUN_TIME_MS_));
+	motor1_counts = CAR_ODOMETRY_Motor1_GetTotalCounts() - motor1_counts;
+	motor2_counts = CAR_ODOMETRY_Motor2_GetTotalCounts() - motor2_counts;
+	ticks = TIMER_TICK_GetTicks() - start_tick;
+	CAR_MOVEMENT_Stop();
+	*motor1_speed = (u16_t) (motor1_counts * CAR_ODOMETRY_MM_PER_ENCODER_COUNT_ * 1000000 / ((double) ticks * TIMER_TICK_PERIOD_US_));
+	*motor2_speed = (u16_t) (motor2_counts * CAR_ODOMETRY_MM_PER_ENCODER_COUNT_ * 1000000 / ((double) ticks * TIMER_TICK_PERIOD_US_));
+	CAR_CALIBRATION_Return(duty, ticks + TIMER_TICK_MS_TO_TICKS(CAR_CALIBRATION_SETTLE_TIME_MS_));
+}
+
+void CAR_CALIBRATION_MeasureByUltrasonic(u8_t duty, u16_t* motor1_speed, u16_t* motor2_speed){
+	double side_start, side_end;
+	double front_start, front_end;
+	double moving_start, moving_end;
+	double speed;
+	double difference = 0;
+	u32_t start_tick;
+	u32_t ticks;
+	u32_t total_ticks;
+	/*
+	 * NOTE:
+	 * 		The servo uses Timer1, which also drives motor 1 in this mode, so the servo is moved only while the car is stopped.
+	 * 		Distances are taken from ultrasonic_distance (cm as double) and not ULTRASONIC_GetDistance_cm_(), to keep the millimeters.
+	 *
+	 */
+	SERVO_90_CW();
+	ULTRASONIC_TRIG_Send();
+	side_start = ultrasonic_distance * 10;
+	SERVO_Center();
+	ULTRASONIC_TRIG_Send();
+	front_start = ultrasonic_distance * 10;
+	total_ticks = TIMER_TICK_GetTicks();
+	CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_FORWARD, duty, duty);
+	CAR_CALIBRATION_Wait(TIMER_TICK_MS_TO_TICKS(CAR_CALIBRATION_SETTLE_TIME_MS_));
+	start_tick = TIMER_TICK_GetTicks();
+	ULTRASONIC_TRIG_Send();
+	moving_start = ultrasonic_distance * 10;
+	CAR_CALIBRATION_Wait(TIMER_TICK_MS_TO_TICKS(CAR_CALIBRATION_RUN_TIME_MS_));
+	ticks = TIMER_TICK_GetTicks() - start_tick;		// Both readings are taken right after their triggers, so the time between them is the same.
+	ULTRASONIC_TRIG_Send();
+	moving_end = ultrasonic_distance * 10;
+	CAR_MOVEMENT_Stop();
+	total_ticks = TIMER_TICK_GetTicks() - total_ticks;
+	CAR_CALIBRATION_Wait(TIMER_TICK_MS_TO_TICKS(CAR_CALIBRATION_SETTLE_TIME_MS_));
+	ULTRASONIC_TRIG_Send();
+	front_end = ultrasonic_distance * 10;
+	SERVO_90_CW();
+	ULTRASONIC_TRIG_Send();
+	side_end = ultrasonic_distance * 10;
+	SERVO_Center();
+	speed = (moving_start - moving_end) * 1000000 / ((double) ticks * TIMER_TICK_PERIOD_US_);
+	if (speed < 0){
+		speed = 0;
+	}
+	// Drifting away from the right wall means that the right wheel (motor 1) is faster.
+	if (front_start - front_end > 50){
+		difference = 2 * CAR_WHEEL_BASE_MM_ * speed * (side_end - side_start) / ((front_start - front_end) * (front_start - front_end));
+	}
+	*motor1_speed = (speed + difference / 2 > 0) ? (u16_t) (speed + difference / 2) : 0;
+	*motor2_speed = (speed - difference / 2 > 0) ? (u16_t) (speed - difference / 2) : 0;
+	CAR_CALIBRATION_Return(duty, total_ticks);
+}
+
+void CAR_CALIBRATION_Return(u8_t duty, u32_t ticks){
+	CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_BACKWARD, duty, duty);
+	CAR_CALIBRATION_Wait(ticks);
+	CAR_MOVEMENT_Stop();
+	CAR_CALIBRATION_Wait(TIMER_TICK_MS_TO_TICKS(CAR_CALIBRATION_SETTLE_TIME_MS_));
+}
+
+void CAR_CALIBRATION_Wait(u32_t ticks){
+	u32_t start_tick = TIMER_TICK_GetTicks();
+	while (TIMER_TICK_GetTicks() - start_tick < ticks);
+}
@@ -0,0 +1,176 @@
+/*
+ * CALIBRATION.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef HAL_CAR_CALIBRATION_CALIBRATION_H_
+#define HAL_CAR_CALIBRATION_CALIBRATION_H_
+
+/* EEPROM */
+/*
+ * NOTE:
+ * 		The speed tables take the first 48 bytes of the EEPROM, so other modules must store their data from address 64.
+ * 		The version must be increased whenever CAR_calibration_data is changed, so an old table is not loaded by mistake.
+ *
+ */
+#define CAR_CALIBRATION_EEPROM_ADDRESS		0
+#define CAR_CALIBRATION_MAGIC				0xCA
+#define CAR_CALIBRATION_VERSION				2
+
+/* Timing */
+#define CAR_CALIBRATION_SETTLE_TIME_MS_		300		// Time for the motors to reach their speed (or to stop) before measuring.
+#define CAR_CALIBRATION_RUN_TIME_MS_		1000	// Time that the speed is measured over at each duty point.
+
+/* PWM Characterization */
+#define CAR_CALIBRATION_PWM_DUTIES			3		// Duty cycles tested at each PWM frequency: 30%, 60% and 90%.
+#define CAR_CALIBRATION_PWM_FIRST_DUTY		30
+#define CAR_CALIBRATION_PWM_DUTY_STEP		30
+#define CAR_CALIBRATION_PWM_MISMATCH_PERMILLE	50	// Frequencies where the motors differ by more than 5% are used only if none is better.
+
+/* Sources */
+typedef enum{
+	CAR_CALIBRATION_ENCODERS,		// Wheel speed is measured by the encoders of each wheel.
+	CAR_CALIBRATION_ULTRASONIC		// Wheel speed is measured by the distance to a wall in front and the drift from a wall on the right.
+} CAR_calibration_source;
+
+/* Data */
+typedef struct{
+	u8_t magic;
+	u8_t version;
+	u16_t motor1_speeds[CAR_SPEED_TABLE_POINTS];	// mm/s at duty cycles 0%, 10%, ..., 100%.
+	u16_t motor2_speeds[CAR_SPEED_TABLE_POINTS];
+	u8_t pwm_frequency;								// CAR_pwm_frequency that the tables were measured at.
+	u8_t checksum;
+} CAR_calibration_data;
+
+typedef struct{
+	u16_t motor1_speeds[CAR_CALIBRATION_PWM_DUTIES];	// mm/s at 30%, 60% and 90%.
+	u16_t motor2_speeds[CAR_CALIBRATION_PWM_DUTIES];
+	u16_t mismatch;										// Difference between the motors relative to their speed (per mille).
+} CAR_pwm_response;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+u8_t CAR_CALIBRATION_Run(CAR_calibration_source source);
+CAR_pwm_frequency CAR_CALIBRATION_CharacterizePwm(CAR_calibration_source source, CAR_pwm_response* responses);
+u8_t CAR_CALIBRATION_Load(void);
+void CAR_CALIBRATION_Save(void);
+void CAR_CALIBRATION_Clear(void);
+u8_t CAR_CALIBRATION_Checksum(void);
+void CAR_CALIBRATION_MeasureByEncoders(u8_t duty, u16_t* motor1_speed, u16_t* motor2_speed);
+void CAR_CALIBRATION_MeasureByUltrasonic(u8_t duty, u16_t* motor1_speed, u16_t* motor2_speed);
+void CAR_CALIBRATION_Return(u8_t duty, u32_t ticks);
+void CAR_CALIBRATION_Wait(u32_t ticks);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	CAR_CALIBRATION_Run(CAR_calibration_source source):
+ * 				@brief	Measure the speed of each motor at every duty point, save the tables into the EEPROM and apply them.
+ *
+ * 				@details
+ * 						- The motors must be initialized with CAR_DC_MOTORS_DIFFERENT_SPEEDS.
+ * 						- The system tick, the ultrasonic sensor (or the encoders and CAR_ODOMETRY) must be initialized first.
+ * 						- At each duty point the car drives forward, then backward for the same time, so it stays near where it started.
+ * 						- For CAR_CALIBRATION_ULTRASONIC, place the car facing a wall about 1.5 meters away, and parallel to a straight wall
+ * 						  about 30 cm on its right.
+ * 						- A speed lower than the one at the previous duty point is taken as noise and replaced by it,
+ * 						  so the tables always increase.
+ * 						- It blocks for about half a minute.
+ *
+ * 				@param source: How the wheel speed is measured (encoders or ultrasonic).
+ *
+ * 				@return 1 if the tables are saved, 0 if the mode is wrong or the car did not move.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_CharacterizePwm(CAR_calibration_source source, CAR_pwm_response* responses):
+ * 				@brief	Measure the speed of both motors at every PWM frequency and select the best one.
+ *
+ * 				@details
+ * 						- At each frequency, both motors are measured at 30%, 60% and 90% duty like CAR_CALIBRATION_Run().
+ * 						- The best frequency is the one with the highest speed (the least losses) among the ones where the motors
+ * 						  match within 5%. If none matches, the one with the least mismatch is selected.
+ * 						- The selected frequency is applied, and the speed tables are disabled since they were measured at another
+ * 						  frequency, so CAR_CALIBRATION_Run() should be called next to measure and save them.
+ * 						- The same conditions of CAR_CALIBRATION_Run() apply, and it blocks for about 40 seconds.
+ *
+ * 				@param source: How the wheel speed is measured (encoders or ultrasonic).
+ * 				@param responses: Array of CAR_PWM_FREQUENCIES elements to store the measurements in (or NULL).
+ *
+ * 				@return CAR_pwm_frequency that was selected.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_Load(void):
+ * 				@brief	Load the speed tables and their PWM frequency from the EEPROM and apply them to CAR_MOVEMENT.
+ *
+ * 				@return 1 if valid tables are loaded, 0 if the car was never calibrated (or the data is corrupted).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_Save(void):
+ * 				@brief	Write the speed tables into the EEPROM.
+ *
+ * 				@details
+ * 						- Only the bytes that changed are written.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_Clear(void):
+ * 				@brief	Stop using the speed tables and mark the ones in the EEPROM as invalid.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_Checksum(void):
+ * 				@brief	Calculate the checksum of the calibration data.
+ *
+ * 				@return u8_t sum of all the bytes before the checksum.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_MeasureByEncoders(u8_t duty, u16_t* motor1_speed, u16_t* motor2_speed):
+ * 				@brief	Measure the speed of both wheels at a duty cycle using the encoders.
+ *
+ * 				@param duty: Duty cycle of both motors (1 to 100%).
+ * 				@param motor1_speed: Pointer to where the speed of motor 1 (mm/s) is stored.
+ * 				@param motor2_speed: Pointer to where the speed of motor 2 (mm/s) is stored.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_MeasureByUltrasonic(u8_t duty, u16_t* motor1_speed, u16_t* motor2_speed):
+ * 				@brief	Measure the speed of both wheels at a duty cycle using the ultrasonic sensor.
+ *
+ * 				@details
+ * 						- The mean speed is taken from how fast the distance to the front wall decreases while moving.
+ * 						- The difference between the wheels is taken from how far the car drifts from the right wall.
+ * 						  With a small constant turning rate, the drift is d = s^2 * (v1 - v2) / (2 * W * v),
+ * 						  where s is the distance moved, W is the wheel base and v is the mean speed.
+ *
+ * 				@param duty: Duty cycle of both motors (1 to 100%).
+ * 				@param motor1_speed: Pointer to where the speed of motor 1 (mm/s) is stored.
+ * 				@param motor2_speed: Pointer to where the speed of motor 2 (mm/s) is stored.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_Return(u8_t duty, u32_t ticks):
+ * 				@brief	Drive backward at a duty cycle for a number of ticks, then stop.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CALIBRATION_Wait(u32_t ticks):
+ * 				@brief	Wait for a number of ticks.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* HAL_CAR_CALIBRATION_CALIBRATION_H_ */
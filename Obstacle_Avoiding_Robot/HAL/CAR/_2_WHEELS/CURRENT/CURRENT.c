@@ -0,0 +1,130 @@
+/*
+ * CURRENT.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../../../LIB/STD_TYPES.h"
+#include "../../../../LIB/BIT_MATH.h"
+#include "../../../../MCAL/INTERRUPT/INTERRUPT.h"
+#include "../../../../MCAL/ADC/ADC.h"
+#include "../../../../MCAL/TIMER/TICK/TICK.h"
+#include "../MOVEMENT/MOVEMENT.h"
+#include "CURRENT.h"
+
+/* Variables */
+volatile u16_t current_filtered[CAR_CURRENT_CHANNELS] = {0, 0, 0};	// ADC counts as Q10.6, so the filter does not lose the small changes.
+u8_t current_result_channel = 0;				// Index (motor 1, motor 2 or battery) of the conversion that completes next.
+u8_t current_mux_channel = 0;					// Index selected in ADMUX.
+const u8_t current_channels[CAR_CURRENT_CHANNELS] = {CAR_CURRENT_MOTOR1_CHANNEL, CAR_CURRENT_MOTOR2_CHANNEL, CAR_CURRENT_BATTERY_CHANNEL};
+u8_t current_stall_ticks[2] = {0, 0};
+volatile u8_t current_stalled = 0;
+u16_t current_stall_threshold;					// ADC counts at 100% duty.
+
+/* Function Pointers */
+void (*current_stall_function_pointer) (void)=NULL;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void CAR_CURRENT_Init(void){
+	current_stall_threshold = CAR_CURRENT_MA_TO_COUNTS(CAR_CURRENT_STALL_MA_);
+	ADC_Init(ADC_INTERNAL_2_56V, ADC_PRESCALER_128);
+	ADC_SetCallBack(CAR_CURRENT_ADC_InterruptHandler);
+	ADC_EnableInterrupt();
+	ADC_StartFreeRunning(CAR_CURRENT_MOTOR1_CHANNEL);
+	TIMER_TICK_Init();
+	TIMER_TICK_AddCallBack(CAR_CURRENT_Update);
+}
+
+u16_t CAR_CURRENT_Motor1_GetCurrent_mA_(void){
+	u16_t counts;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	counts = current_filtered[0];
+	SREG = sreg;
+	return (u16_t) ((u32_t) (counts >> CAR_CURRENT_FILTER_SHIFT) * CAR_CURRENT_REFERENCE_MV_ * 1000 / CAR_CURRENT_SHUNT_MILLIOHM_ / ADC_MAXIMUM_VALUE);
+}
+
+u16_t CAR_CURRENT_Motor2_GetCurrent_mA_(void){
+	u16_t counts;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	counts = current_filtered[1];
+	SREG = sreg;
+	return (u16_t) ((u32_t) (counts >> CAR_CURRENT_FILTER_SHIFT) * CAR_CURRENT_REFERENCE_MV_ * 1000 / CAR_CURRENT_SHUNT_MILLIOHM_ / ADC_MAXIMUM_VALUE);
+}
+
+u16_t CAR_CURRENT_GetBattery_mV_(void){
+	u16_t counts;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	counts = current_filtered[CAR_CURRENT_BATTERY_INDEX];
+	SREG = sreg;
+	return (u16_t) ((u32_t) (counts >> CAR_CURRENT_FILTER_SHIFT) * CAR_CURRENT_REFERENCE_MV_ * CAR_CURRENT_BATTERY_DIVIDER / ADC_MAXIMUM_VALUE);
+}
+
+u8_t CAR_CURRENT_GetStalledMotors(void){
+	return current_stalled;
+}
+
+void CAR_CURRENT_SetStallCallBack(void (*local_function_pointer) (void)){
+	current_stall_function_pointer = local_function_pointer;
+}
+
+void CAR_CURRENT_ADC_InterruptHandler(void){
+	u16_t sample = ADC_GetResult() << CAR_CURRENT_FILTER_SHIFT;
+	u8_t index = current_result_channel;
+	/*
+	 * NOTE:
+	 * 		When this runs, the next conversion has already started with the channel in ADMUX,
+	 * 		so the channel changed here is used by the conversion after it.
+	 *
+	 */
+	current_result_channel = current_mux_channel;
+	current_mux_channel++;
+	if (current_mux_channel == CAR_CURRENT_CHANNELS){
+		current_mux_channel = 0;
+	}
+	ADC_SetChannel(current_channels[current_mux_channel]);
+	// First-order low-pass filter: y += (x - y) / 2^shift, done in 16 bits without signed numbers.
+	if (sample > current_filtered[index]){
+		current_filtered[index] += (sample - current_filtered[index]) >> CAR_CURRENT_FILTER_SHIFT;
+	}
+	else{
+		current_filtered[index] -= (current_filtered[index] - sample) >> CAR_CURRENT_FILTER_SHIFT;
+	}
+}
+
+void CAR_CURRENT_Update(void){
+	s8_t speeds[2];
+	u8_t duty;
+	u8_t motor;
+	u8_t new_stall = 0;
+	speeds[0] = CAR_MOVEMENT_Motor1_GetSpeed();
+	speeds[1] = CAR_MOVEMENT_Motor2_GetSpeed();
+	for (motor = 0; motor < 2; motor++){
+		duty = (speeds[motor] < 0) ? -speeds[motor] : speeds[motor];
+		if (duty == 0){
+			CLEAR_BIT(current_stalled, motor);		// The motor is stopped, so it is checked again when it moves.
+		}
+		// This runs inside the Timer0 ISR, so the ADC interrupt cannot change the filtered value while it is read.
+		if (duty < CAR_CURRENT_MINIMUM_DUTY || (current_filtered[motor] >> CAR_CURRENT_FILTER_SHIFT) <= (u32_t) current_stall_threshold * duty / 100){
+			current_stall_ticks[motor] = 0;
+			continue;
+		}
+		if (current_stall_ticks[motor] < TIMER_TICK_MS_TO_TICKS(CAR_CURRENT_STALL_TIME_MS_)){
+			current_stall_ticks[motor]++;
+		}
+		else if (!GET_BIT(current_stalled, motor)){
+			SET_BIT(current_stalled, motor);
+			new_stall = 1;
+		}
+	}
+	if (new_stall && current_stall_function_pointer){
+		current_stall_function_pointer();
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * CURRENT.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef HAL_CAR_CURRENT_CURRENT_H_
+#define HAL_CAR_CURRENT_CURRENT_H_
+
+/* Channels */
+/*
+ * NOTE:
+ * 		Each half of the L293 is grounded through its own shunt resistor, and the voltage on the shunt is read by the ADC.
+ * 		PA0 and PA1 are free, since the LCD uses only PA4 to PA7 in 4-bit mode.
+ *
+ */
+#define CAR_CURRENT_MOTOR1_CHANNEL		ADC_CHANNEL_0
+#define CAR_CURRENT_MOTOR2_CHANNEL		ADC_CHANNEL_1
+#define CAR_CURRENT_BATTERY_CHANNEL		ADC_CHANNEL_2		// Battery voltage through a divider on PA2.
+#define CAR_CURRENT_CHANNELS			3					// Converted one after the other: motor 1, motor 2, battery.
+#define CAR_CURRENT_BATTERY_INDEX		2
+
+/* Hardware */
+#define CAR_CURRENT_SHUNT_MILLIOHM_		500
+#define CAR_CURRENT_REFERENCE_MV_		2560		// Internal 2.56V reference.
+#define CAR_CURRENT_BATTERY_DIVIDER		4			// 30k over 10k, so up to 10.24V can be read.
+
+/* Stall Detection */
+/*
+ * NOTE:
+ * 		The current flows only while the PWM output is high, so the filtered reading is proportional to the duty cycle.
+ * 		The threshold is for 100% duty and is scaled down by the duty cycle of each motor.
+ *
+ */
+#define CAR_CURRENT_STALL_MA_			1000		// Average motor current at 100% duty that means the wheel is jammed.
+#define CAR_CURRENT_STALL_TIME_MS_		200			// The current must stay above the threshold this long (longer than the start-up current).
+#define CAR_CURRENT_MINIMUM_DUTY		20			// Below this duty cycle the current is too low to be measured reliably.
+#define CAR_CURRENT_FILTER_SHIFT		6			// Filter time constant is 2^6 samples (about 20ms per channel).
+
+#define CAR_CURRENT_MA_TO_COUNTS(ma)	((u16_t) ((u32_t) (ma) * CAR_CURRENT_SHUNT_MILLIOHM_ / 1000 * ADC_MAXIMUM_VALUE / CAR_CURRENT_REFERENCE_MV_))
+
+/* Stalled Motors */
+#define CAR_CURRENT_MOTOR1_STALLED		0x01
+#define CAR_CURRENT_MOTOR2_STALLED		0x02
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void CAR_CURRENT_Init(void);
+u16_t CAR_CURRENT_Motor1_GetCurrent_mA_(void);
+u16_t CAR_CURRENT_Motor2_GetCurrent_mA_(void);
+u16_t CAR_CURRENT_GetBattery_mV_(void);
+u8_t CAR_CURRENT_GetStalledMotors(void);
+void CAR_CURRENT_SetStallCallBack(void (*local_function_pointer) (void));
+void CAR_CURRENT_ADC_InterruptHandler(void);
+void CAR_CURRENT_Update(void);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	CAR_CURRENT_Init(void):
+ * 				@brief	Start monitoring the current of both motors and the battery voltage.
+ *
+ * 				@details
+ * 						- The ADC runs in free running mode and its interrupt filters each result, going through the three channels.
+ * 						- The stall check runs from the system tick, so the application does not need to poll anything.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CURRENT_Motor1_GetCurrent_mA_(void), CAR_CURRENT_Motor2_GetCurrent_mA_(void):
+ * 				@brief	Get the filtered (average) current of the motor.
+ *
+ * 				@return u16_t current in mA.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CURRENT_GetBattery_mV_(void):
+ * 				@brief	Get the filtered voltage of the battery.
+ *
+ * 				@return u16_t voltage in mV.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CURRENT_GetStalledMotors(void):
+ * 				@brief	Get the motors that are stalled now.
+ *
+ * 				@details
+ * 						- A motor stays stalled until it is commanded to stop (speed 0), then it is checked again when it moves.
+ *
+ * 				@return u8_t CAR_CURRENT_MOTOR1_STALLED | CAR_CURRENT_MOTOR2_STALLED, or 0.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CURRENT_SetStallCallBack(void (*local_function_pointer) (void)):
+ * 				@brief	Set callback function to be called when a motor stalls (e.g. CAR_MOVEMENT_StallHandler).
+ *
+ * 				@details
+ * 						- It is called from the timer tick ISR once for each stall.
+ *
+ * 				@param local_function_pointer: Pointer to the function that will be called on a stall.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CURRENT_ADC_InterruptHandler(void):
+ * 				@brief	Filter the last ADC result into the current of its motor (ADC callback).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_CURRENT_Update(void):
+ * 				@brief	Check both motors for a stall (Tick callback).
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* HAL_CAR_CURRENT_CURRENT_H_ */
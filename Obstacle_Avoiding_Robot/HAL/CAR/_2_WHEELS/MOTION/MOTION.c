@@ -0,0 +1,209 @@
+/*
+ * MOTION.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../../../LIB/STD_TYPES.h"
+#include "../../../../LIB/BIT_MATH.h"
+#include "../../../../MCAL/INTERRUPT/INTERRUPT.h"
+#include "../../../../MCAL/TIMER/TICK/TICK.h"
+#include "../MOVEMENT/MOVEMENT.h"
+#include "../ODOMETRY/ODOMETRY.h"
+#include "MOTION.h"
+
+/* Variables */
+CAR_motion_command motion_queue[CAR_MOTION_QUEUE_SIZE];
+volatile u8_t motion_queue_head = 0;			// Next free slot, written only by the application.
+volatile u8_t motion_queue_tail = 0;			// Next primitive to run, written only by the tick.
+volatile u8_t motion_running = 0;
+volatile u8_t motion_progress = 0;
+volatile u8_t motion_completed = 0;
+volatile u8_t motion_failed = 0;
+CAR_motion_command motion_current;
+u32_t motion_target;							// Q16.16 mm for distances, binary angle for rotations and ticks for waiting.
+u32_t motion_done;
+u32_t motion_start_travelled;
+u16_t motion_last_heading;
+
+/* Function Pointers */
+void (*motion_function_pointer) (void)=NULL;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void CAR_MOTION_Init(void){
+	TIMER_TICK_Init();
+	TIMER_TICK_AddCallBack(CAR_MOTION_Update);
+}
+
+u8_t CAR_MOTION_Enqueue(CAR_motion_primitive primitive, s16_t value){
+	u8_t next_head = (motion_queue_head + 1) % CAR_MOTION_QUEUE_SIZE;
+	if (next_head == motion_queue_tail){		// Queue is full.
+		return 0;
+	}
+	motion_queue[motion_queue_head].primitive = primitive;
+	motion_queue[motion_queue_head].value = value;
+	motion_queue[motion_queue_head].radius = 0;
+	motion_queue_head = next_head;				// The slot is published after it is filled, so the tick never reads a half-written command.
+	return 1;
+}
+
+u8_t CAR_MOTION_EnqueueArc(s16_t distance_mm, s16_t radius_mm){
+	u8_t next_head = (motion_queue_head + 1) % CAR_MOTION_QUEUE_SIZE;
+	if (next_head == motion_queue_tail){
+		return 0;
+	}
+	motion_queue[motion_queue_head].primitive = CAR_MOTION_ARC;
+	motion_queue[motion_queue_head].value = distance_mm;
+	motion_queue[motion_queue_head].radius = radius_mm;
+	motion_queue_head = next_head;
+	return 1;
+}
+
+void CAR_MOTION_Abort(void){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	motion_queue_tail = motion_queue_head;
+	motion_running = 0;
+	motion_progress = 0;
+	CAR_MOVEMENT_Stop();
+	SREG = sreg;
+}
+
+u8_t CAR_MOTION_IsIdle(void){
+	return (!motion_running && motion_queue_head == motion_queue_tail);
+}
+
+u8_t CAR_MOTION_GetPending(void){
+	return ((motion_queue_head + CAR_MOTION_QUEUE_SIZE - motion_queue_tail) % CAR_MOTION_QUEUE_SIZE) + motion_running;
+}
+
+u8_t CAR_MOTION_GetProgress(void){
+	return motion_progress;
+}
+
+u8_t CAR_MOTION_GetCompleted(void){
+	return motion_completed;
+}
+
+u8_t CAR_MOTION_GetFailed(void){
+	return motion_failed;
+}
+
+void CAR_MOTION_SetCallBack(void (*local_function_pointer) (void)){
+	motion_function_pointer = local_function_pointer;
+}
+
+u8_t CAR_MOTION_Start(void){
+	CAR_pose pose;
+	s16_t value = motion_current.value;
+	s32_t curvature;
+	CAR_ODOMETRY_GetPose(&pose);
+	motion_start_travelled = pose.travelled;
+	motion_last_heading = pose.heading;
+	motion_done = 0;
+	switch (motion_current.primitive){
+	case CAR_MOTION_DRIVE:
+		motion_target = (u32_t) ((value < 0) ? -value : value) << 16;
+		if (value < 0){
+			CAR_MOVEMENT_Backward();
+		}
+		else{
+			CAR_MOVEMENT_Forward();
+		}
+		break;
+	case CAR_MOTION_ROTATE:
+		motion_target = ((u32_t) ((value < 0) ? -value : value) << 16) / 360;
+		if (value < 0){
+			CAR_MOVEMENT_Right();
+		}
+		else{
+			CAR_MOVEMENT_Left();
+		}
+		break;
+	case CAR_MOTION_ARC:
+		motion_target = (u32_t) ((value < 0) ? -value : value) << 16;
+		if (motion_current.radius == 0){
+			curvature = 0;
+		}
+		else{
+			curvature = 1000000L / motion_current.radius;	// Radius in mm to curvature in 1/km.
+			curvature = (curvature > 32767) ? 32767 : ((curvature < -32767) ? -32767 : curvature);
+		}
+		if (!CAR_MOVEMENT_Drive(CAR_MOTION_ARC_SPEED, (s16_t) curvature)){
+			return 0;					// Not possible in the same speed mode, so the previous motion would go on instead.
+		}
+		break;
+	case CAR_MOTION_STOP:
+		motion_target = 0;
+		CAR_MOVEMENT_Stop();
+		break;
+	case CAR_MOTION_WAIT:
+		motion_target = TIMER_TICK_MS_TO_TICKS((value < 0) ? -value : value);
+		break;
+	}
+	return 1;
+}
+
+void CAR_MOTION_Update(void){
+	CAR_pose pose;
+	s16_t rotation;
+	if (!motion_running){
+		if (motion_queue_head == motion_queue_tail){
+			return;
+		}
+		motion_current = motion_queue[motion_queue_tail];
+		motion_queue_tail = (motion_queue_tail + 1) % CAR_MOTION_QUEUE_SIZE;
+		motion_running = 1;
+		motion_progress = 0;
+		if (!CAR_MOTION_Start()){
+			// The next primitives expect the car where this one would have left it, so the whole queue is dropped.
+			motion_queue_tail = motion_queue_head;
+			motion_running = 0;
+			motion_failed++;
+			CAR_MOVEMENT_Stop();
+			return;
+		}
+	}
+	switch (motion_current.primitive){
+	case CAR_MOTION_DRIVE:
+	case CAR_MOTION_ARC:
+		CAR_ODOMETRY_GetPose(&pose);
+		motion_done = pose.travelled - motion_start_travelled;
+		break;
+	case CAR_MOTION_ROTATE:
+		CAR_ODOMETRY_GetPose(&pose);
+		rotation = (s16_t) (pose.heading - motion_last_heading);	// The heading changes much less than half a turn in a tick.
+		motion_last_heading = pose.heading;
+		motion_done += (rotation < 0) ? -rotation : rotation;
+		break;
+	case CAR_MOTION_WAIT:
+		motion_done++;
+		break;
+	default:
+		break;
+	}
+	if (motion_done < motion_target){
+		// Long distances are scaled down first, so multiplying by 100 does not overflow 32 bits.
+		if (motion_target > 0x00FFFFFF){
+			motion_progress = (u8_t) ((motion_done >> 8) * 100 / (motion_target >> 8));
+		}
+		else{
+			motion_progress = (u8_t) (motion_done * 100 / motion_target);
+		}
+		return;
+	}
+	motion_progress = 100;
+	motion_running = 0;
+	motion_completed++;
+	if (motion_queue_head == motion_queue_tail){		// It was the last primitive.
+		CAR_MOVEMENT_Stop();
+		if (motion_function_pointer){
+			motion_function_pointer();
+		}
+	}
+}
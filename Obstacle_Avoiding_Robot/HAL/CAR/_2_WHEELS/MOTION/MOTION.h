@@ -0,0 +1,168 @@
+/*
+ * MOTION.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef HAL_CAR_MOTION_MOTION_H_
+#define HAL_CAR_MOTION_MOTION_H_
+
+#define CAR_MOTION_QUEUE_SIZE		8			// Maximum number of primitives waiting in the queue (one slot is always kept empty).
+#define CAR_MOTION_ARC_SPEED		60			// Speed percentage of the center of the car during an arc.
+
+/* Primitives */
+typedef enum{
+	CAR_MOTION_DRIVE,			// Drive straight for a distance in mm (negative means backward).
+	CAR_MOTION_ROTATE,			// Rotate in place by an angle in degrees (positive means left, counterclockwise).
+	CAR_MOTION_ARC,				// Drive forward for a distance in mm along a circle of a radius in mm (positive radius turns left).
+	CAR_MOTION_STOP,			// Stop the motors.
+	CAR_MOTION_WAIT				// Keep the motors as they are for a time in ms.
+} CAR_motion_primitive;
+
+typedef struct{
+	CAR_motion_primitive primitive;
+	s16_t value;				// Distance, angle or time depending on the primitive.
+	s16_t radius;				// Used only by CAR_MOTION_ARC.
+} CAR_motion_command;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void CAR_MOTION_Init(void);
+u8_t CAR_MOTION_Enqueue(CAR_motion_primitive primitive, s16_t value);
+u8_t CAR_MOTION_EnqueueArc(s16_t distance_mm, s16_t radius_mm);
+void CAR_MOTION_Abort(void);
+u8_t CAR_MOTION_IsIdle(void);
+u8_t CAR_MOTION_GetPending(void);
+u8_t CAR_MOTION_GetProgress(void);
+u8_t CAR_MOTION_GetCompleted(void);
+u8_t CAR_MOTION_GetFailed(void);
+void CAR_MOTION_SetCallBack(void (*local_function_pointer) (void));
+u8_t CAR_MOTION_Start(void);
+void CAR_MOTION_Update(void);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	CAR_MOTION_Init(void):
+ * 				@brief	Initialize the motion executor.
+ *
+ * 				@details
+ * 						- Registers CAR_MOTION_Update() as a tick callback.
+ * 						- Must be called after CAR_ODOMETRY_Init(), so the pose is updated before the executor reads it in every tick.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_Enqueue(CAR_motion_primitive primitive, s16_t value):
+ * 				@brief	Add a primitive to the end of the queue.
+ *
+ * 				@details
+ * 						- Returns immediately; the primitives run one after the other from the timer tick.
+ * 						- While the queue is running, the application must not call the CAR_MOVEMENT functions itself.
+ *
+ * 				@param primitive: The primitive (drive, rotate, stop or wait).
+ * 				@param value: Distance in mm, angle in degrees or time in ms. It is ignored for CAR_MOTION_STOP.
+ *
+ * 				@return 1 if the primitive is added, 0 if the queue is full.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_EnqueueArc(s16_t distance_mm, s16_t radius_mm):
+ * 				@brief	Add an arc to the end of the queue.
+ *
+ * 				@details
+ * 						- Needs the motors to be initialized with CAR_DC_MOTORS_DIFFERENT_SPEEDS. Otherwise, when the arc starts,
+ * 						  the car is stopped, the queue is dropped and CAR_MOTION_GetFailed() is increased.
+ *
+ * 				@param distance_mm: Distance that the center of the car moves along the arc.
+ * 				@param radius_mm: Radius of the arc (positive turns left, negative turns right).
+ *
+ * 				@return 1 if the arc is added, 0 if the queue is full.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_Abort(void):
+ * 				@brief	Stop the running primitive, drop all the waiting ones and stop the car.
+ *
+ * 				@details
+ * 						- The completion callback is not called.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_IsIdle(void):
+ * 				@brief	Check if no primitive is running or waiting.
+ *
+ * 				@return 1 if idle, 0 otherwise.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_GetPending(void):
+ * 				@brief	Get the number of primitives not finished yet, including the running one.
+ *
+ * 				@return u8_t
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_GetProgress(void):
+ * 				@brief	Get the progress of the running primitive.
+ *
+ * 				@return u8_t (0 to 100%), 0 if no primitive is running.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_GetCompleted(void):
+ * 				@brief	Get the number of primitives completed since the initialization (wraps after 255).
+ *
+ * 				@return u8_t
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_GetFailed(void):
+ * 				@brief	Get the number of primitives that could not start since the initialization (wraps after 255).
+ *
+ * 				@details
+ * 						- When a primitive cannot start (e.g. an arc in the same speed mode), the car is stopped and the waiting
+ * 						  primitives are dropped, like CAR_MOTION_Abort(), so the queue becomes idle without the callback.
+ *
+ * 				@return u8_t
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_SetCallBack(void (*local_function_pointer) (void)):
+ * 				@brief	Set callback function to be called when the last primitive in the queue is completed.
+ *
+ * 				@details
+ * 						- It is called from the timer tick ISR, so it must be short.
+ *
+ * 				@param local_function_pointer: Pointer to the function that will be called on completion.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_Start(void):
+ * 				@brief	Start the primitive taken from the queue (called by CAR_MOTION_Update()).
+ *
+ * 				@details
+ * 						- Saves the pose at the start, so the progress is measured from it.
+ *
+ * 				@return 1 if the primitive is started, 0 if it is not possible (an arc in the same speed mode).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOTION_Update(void):
+ * 				@brief	Run the queue (Tick callback).
+ *
+ * 				@details
+ * 						- Starts the next primitive when the running one is completed.
+ * 						- Stops the car when the queue becomes empty.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* HAL_CAR_MOTION_MOTION_H_ */
@@ -8,8 +8,10 @@
 #include "../../../../LIB/BIT_MATH.h"
 #include "../../../../MCAL/DIO/DIO.h"
 #include "../../../../MCAL/TIMER/TIMER.h"
+#include "../../../../MCAL/INTERRUPT/INTERRUPT.h"
 #include "../../../../HAL/LCD/LCD.h"
 #include "../../../H_BRIDGE/L293/H_BRIDGE.h"
+#include "../../../SERVO/SERVO.h"
 #include "MOVEMENT.h"
 
 /* Variables */
@@ -17,6 +19,23 @@ u8_t DC_motors_speed_mode;
 u8_t DC_motors_default_speed = 60;					// Initialize the default speed for both motors as 60%.
 u8_t DC_motor1_default_speed = 60;					// Initialize the default speed for motor 1 as 60%.
 u8_t DC_motor2_default_speed = 60;					// Initialize the default speed for motor 2 as 60%.
+u8_t DC_motors_direction = CAR_FORWARD;
+volatile s8_t DC_motor1_command = 0;				// Signed speed percentage that motor 1 is driven with now (positive means forward).
+volatile s8_t DC_motor2_command = 0;				// Signed speed percentage that motor 2 is driven with now (positive means forward).
+const u16_t* DC_motor1_speed_table = NULL;			// Measured wheel speed (mm/s) of motor 1 at each duty point, NULL when not calibrated.
+const u16_t* DC_motor2_speed_table = NULL;			// Measured wheel speed (mm/s) of motor 2 at each duty point, NULL when not calibrated.
+u16_t DC_motors_top_speed = 0;						// The highest speed that both motors can reach (mm/s).
+u8_t DC_motors_pwm_running = 0;						// Set when Timer1 and Timer2 are started together in different speeds mode.
+u8_t DC_motors_phase_alignment = 1;
+u8_t DC_motors_pwm_frequency = CAR_PWM_976_HZ;
+u8_t DC_motor1_dead_band = CAR_MOTOR_DEAD_BAND_DEFAULT;	// Duty cycle (%) below which motor 1 does not turn, used only when not calibrated.
+u8_t DC_motor2_dead_band = CAR_MOTOR_DEAD_BAND_DEFAULT;	// Duty cycle (%) below which motor 2 does not turn, used only when not calibrated.
+u8_t DC_motor1_linearization[CAR_SPEED_TABLE_POINTS];	// OCR1A value at speeds 0+%, 10%, ..., 100%.
+u8_t DC_motor2_linearization[CAR_SPEED_TABLE_POINTS];	// OCR2 value at speeds 0+%, 10%, ..., 100%.
+
+/* Prescalers of each PWM frequency */
+const TIMER1_prescaler DC_motors_timer1_prescalers[CAR_PWM_FREQUENCIES] = {TIMER1_PRESCALER_8, TIMER1_PRESCALER_64, TIMER1_PRESCALER_256, TIMER1_PRESCALER_1024};
+const TIMER2_prescaler DC_motors_timer2_prescalers[CAR_PWM_FREQUENCIES] = {TIMER2_PRESCALER_8, TIMER2_PRESCALER_64, TIMER2_PRESCALER_256, TIMER2_PRESCALER_1024};
 
 
 /********************************\
@@ -27,11 +46,73 @@ void CAR_MOVEMENT_Motors_Init(CAR_motors_speed_mode mode){
 	H_BRIDGE_L293_Motor_Init(H_EN1,H_A1,H_A2);
 	H_BRIDGE_L293_Motor_Init(H_EN2,H_A3,H_A4);
 	DC_motors_speed_mode = mode;
+	CAR_MOVEMENT_BuildLinearization();
+}
+
+CAR_motors_speed_mode CAR_MOVEMENT_GetSpeedMode(void){
+	return DC_motors_speed_mode;
+}
+
+u8_t CAR_MOVEMENT_SetSpeedMode(CAR_motors_speed_mode mode){
+	u8_t motor1_speed = (DC_motor1_command < 0) ? -DC_motor1_command : DC_motor1_command;
+	u8_t motor2_speed = (DC_motor2_command < 0) ? -DC_motor2_command : DC_motor2_command;
+	u8_t sreg;
+	if (mode == DC_motors_speed_mode){
+		return 1;
+	}
+	if (mode == CAR_DC_MOTORS_DIFFERENT_SPEEDS && SERVO_IsMoving()){
+		return 0;							// Timer1 still makes the servo pulses, so it cannot be taken yet.
+	}
+	sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();		// No PWM interrupt may run with the callbacks of one mode and the timers of the other.
+	DC_motors_speed_mode = mode;
+	/*
+	 * NOTE:
+	 * 		Only the compare values and the callbacks are changed while the motors move, and TIMER_Timer2_Init() is not called,
+	 * 		so Timer2 keeps counting and its current period is not cut. OCR2 is double buffered in fast PWM mode, so the new duty
+	 * 		starts with the next period.
+	 *
+	 */
+	if (mode == CAR_DC_MOTORS_SAME_SPEED){
+		TIMER_Timer1_Stop();
+		TIMER_Timer1_OCA_DisableInterrupt();
+		TIMER_Timer1_IC_DisableInterrupt();
+		DC_motors_pwm_running = 0;
+		if (motor1_speed || motor2_speed){
+			CAR_MOVEMENT_SameSpeed_SetCallBacks(DC_motors_direction);
+			CAR_MOVEMENT_SameSpeed_SetDuty((motor1_speed + motor2_speed) / 2.0);
+		}
+	}
+	else if (motor1_speed || motor2_speed){
+		CAR_MOVEMENT_DifferentSpeeds_SetCallBacks(DC_motors_direction);
+		CAR_MOVEMENT_DifferentSpeeds_SetDuties(motor1_speed, motor2_speed);
+		TIMER_Timer1_OCA_EnableInterrupt();
+		TIMER_Timer1_IC_EnableInterrupt();
+		TIMER_Timer1_Init(TIMER1_FAST_PWM_ICR1, DC_motors_timer1_prescalers[DC_motors_pwm_frequency]);
+		if (DC_motors_phase_alignment){
+			// Only Timer1 is moved, to be half a period ahead of the running Timer2 (within the few counts that pass meanwhile).
+			TIMER_Timer1_TCNT1_Set((u8_t) (TCNT2 + CAR_PWM_PHASE_OFFSET));
+		}
+		DC_motors_pwm_running = 1;
+	}
+	SREG = sreg;
+	return 1;
+}
+
+void CAR_MOVEMENT_SetPwmFrequency(CAR_pwm_frequency frequency){
+	if (frequency >= CAR_PWM_FREQUENCIES){
+		return;
+	}
+	DC_motors_pwm_frequency = frequency;
+	DC_motors_pwm_running = 0;			// The timers start again with the new prescaler, so they must be synchronized again.
+}
+
+CAR_pwm_frequency CAR_MOVEMENT_GetPwmFrequency(void){
+	return DC_motors_pwm_frequency;
 }
 
 void CAR_MOVEMENT_Low(void){
-	H_BRIDGE_L293_Motor_FastStop(H_EN1, H_A1, H_A2);
-	H_BRIDGE_L293_Motor_FastStop(H_EN2, H_A3, H_A4);
+	H_BRIDGE_L293_SetBoth(H_BRIDGE_FAST_STOP, H_BRIDGE_FAST_STOP);
 }
 
 void CAR_MOVEMENT_Motor1_Low(void){
@@ -51,7 +132,45 @@ void CAR_MOVEMENT_Stop(void){
 		TIMER_Timer1_OCA_DisableInterrupt();
 		TIMER_Timer1_IC_DisableInterrupt();
 	}
+	DC_motors_pwm_running = 0;
 	CAR_MOVEMENT_Low();
+	CAR_MOVEMENT_SetCommand(DC_motors_direction, 0, 0);
+}
+
+void CAR_MOVEMENT_StallHandler(void){
+	// A jammed wheel must not be kept at full current, so the duty is cut until the application moves the car again.
+	CAR_MOVEMENT_Stop();
+}
+
+void CAR_MOVEMENT_SetCommand(CAR_directions direction, double motor1_speed, double motor2_speed){
+	DC_motors_direction = direction;
+	switch (direction){
+	case CAR_FORWARD:
+		DC_motor1_command = (s8_t) motor1_speed;
+		DC_motor2_command = (s8_t) motor2_speed;
+		break;
+	case CAR_BACKWARD:
+		DC_motor1_command = -(s8_t) motor1_speed;
+		DC_motor2_command = -(s8_t) motor2_speed;
+		break;
+	// Turning right spins motor 1 (right wheel) backward and motor 2 (left wheel) forward.
+	case CAR_RIGHT:
+		DC_motor1_command = -(s8_t) motor1_speed;
+		DC_motor2_command = (s8_t) motor2_speed;
+		break;
+	case CAR_LEFT:
+		DC_motor1_command = (s8_t) motor1_speed;
+		DC_motor2_command = -(s8_t) motor2_speed;
+		break;
+	}
+}
+
+s8_t CAR_MOVEMENT_Motor1_GetSpeed(void){
+	return DC_motor1_command;
+}
+
+s8_t CAR_MOVEMENT_Motor2_GetSpeed(void){
+	return DC_motor2_command;
 }
 
 
@@ -60,7 +179,7 @@ void CAR_MOVEMENT_Stop(void){
 /******************************************************************/
 
 /* Controlling motors having the same speed */
-void CAR_MOVEMENT_SameSpeed_SetSpeedPercentage(double speed){
+void CAR_MOVEMENT_SameSpeed_SetDuty(double speed){
 	OCR2 = (speed == 0) ? 0 : (u8_t) ((speed * 256) / 100) - 1;		// If speed equals 0, OCR2 = 0, otherwise OCR2 = (u8_t) ((speed * 256) / 100) - 1
 	/*
 	 * NOTE:
@@ -68,16 +187,21 @@ void CAR_MOVEMENT_SameSpeed_SetSpeedPercentage(double speed){
 	 * 		- Making a special condition for speed = 0 to avoid subtracting 1, which would lead to 0 - 1 = 255.
 	 *
 	 */
+	CAR_MOVEMENT_SetCommand(DC_motors_direction, speed, speed);
+}
+
+void CAR_MOVEMENT_SameSpeed_SetSpeedPercentage(double speed){
+	CAR_MOVEMENT_SameSpeed_SetDuty(speed);
 	TIMER_Timer2_OC_EnableInterrupt();
 	TIMER_Timer2_OV_EnableInterrupt();
-	TIMER_Timer2_Init(TIMER2_FAST_PWM, TIMER2_PRESCALER_64);
+	TIMER_Timer2_Init(TIMER2_FAST_PWM, DC_motors_timer2_prescalers[DC_motors_pwm_frequency]);
 }
 
 void CAR_MOVEMENT_SameSpeed_SetDefaultSpeedPercentage(double speed){
 	DC_motors_default_speed = speed;
 }
 
-void CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage(CAR_directions direction, double speed){
+void CAR_MOVEMENT_SameSpeed_SetCallBacks(CAR_directions direction){
 	switch (direction){
 	case CAR_FORWARD:
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
@@ -96,27 +220,52 @@ void CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage(CAR_directions direc
 		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Left_FullSpeed);
 		break;
 	}
+	DC_motors_direction = direction;
+}
+
+void CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage(CAR_directions direction, double speed){
+	CAR_MOVEMENT_SameSpeed_SetCallBacks(direction);
 	CAR_MOVEMENT_SameSpeed_SetSpeedPercentage(speed);
 }
 
 /* Controlling motors having different speeds */
 
-void CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(double motor1_speed, double motor2_speed){
-	TIMER_Timer1_ICR1_Set(255);																	// Set the top of Timer1 (ICR1) as 255 to be like Timer2 which is only 8-bits counter.
-	TIMER_Timer1_OCR1A_Set((motor1_speed == 0) ? 0 : (u8_t) ((motor1_speed * 256) / 100) - 1); 	// If speed equals 0, OCR1A = 0, otherwise OCR1A = (u8_t) ((speed * 256) / 100) - 1
-	OCR2 = ((motor2_speed == 0) ? 0 : (u8_t) ((motor2_speed * 256) / 100) - 1);					// If speed equals 0, OCR2 = 0, otherwise OCR2 = (u8_t) ((speed * 256) / 100) - 1
+void CAR_MOVEMENT_DifferentSpeeds_SetDuties(double motor1_speed, double motor2_speed){
+	CAR_MOVEMENT_SetCommand(DC_motors_direction, motor1_speed, motor2_speed);
+	TIMER_Timer1_ICR1_Set(255);													// Set the top of Timer1 (ICR1) as 255 to be like Timer2 which is only 8-bits counter.
+	TIMER_Timer1_OCR1A_Set(CAR_MOVEMENT_Linearize(DC_motor1_linearization, motor1_speed));
+	OCR2 = CAR_MOVEMENT_Linearize(DC_motor2_linearization, motor2_speed);
 	/*
 	 * NOTE:
-	 * 		- One is subtracted from the calculation because the calculations gives the number of ticks while OCR1A and OCR2 start from 0.
-	 * 		- Making a special condition for speed = 0 to avoid subtracting 1, which would lead to 0 - 1 = 255 for Timer2 or 65,535 for Timer1.
+	 * 		The breakpoints already include the dead band and the speed tables of each motor (see CAR_MOVEMENT_BuildLinearization()),
+	 * 		so changing the speed costs only one integer interpolation per motor.
 	 *
 	 */
+}
+
+void CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(double motor1_speed, double motor2_speed){
+	CAR_MOVEMENT_DifferentSpeeds_SetDuties(motor1_speed, motor2_speed);
 	TIMER_Timer1_OCA_EnableInterrupt();
 	TIMER_Timer1_IC_EnableInterrupt();
 	TIMER_Timer2_OC_EnableInterrupt();
 	TIMER_Timer2_OV_EnableInterrupt();
-	TIMER_Timer1_Init(TIMER1_FAST_PWM_ICR1, TIMER1_PRESCALER_64);
-	TIMER_Timer2_Init(TIMER2_FAST_PWM, TIMER2_PRESCALER_64);
+	TIMER_Timer1_Init(TIMER1_FAST_PWM_ICR1, DC_motors_timer1_prescalers[DC_motors_pwm_frequency]);
+	TIMER_Timer2_Init(TIMER2_FAST_PWM, DC_motors_timer2_prescalers[DC_motors_pwm_frequency]);
+	/*
+	 * NOTE:
+	 * 		The timers are synchronized only when they start, since moving the counters while running would cut a PWM period.
+	 * 		Timer1 runs half a period ahead of Timer2, so the top (IC) interrupt of one motor never meets the overflow interrupt
+	 * 		of the other, and with equal speeds the compare interrupts are half a period apart too.
+	 *
+	 */
+	if (!DC_motors_pwm_running && DC_motors_phase_alignment){
+		TIMER_Timer1_Timer2_Synchronize(CAR_PWM_PHASE_OFFSET, 0);
+	}
+	DC_motors_pwm_running = 1;
+}
+
+void CAR_MOVEMENT_SetPhaseAlignment(u8_t enabled){
+	DC_motors_phase_alignment = enabled;
 }
 
 void CAR_MOVEMENT_DifferentSpeeds_SetDefaultSpeedPercentages(double motor1_speed, double motor2_speed){
@@ -124,42 +273,175 @@ void CAR_MOVEMENT_DifferentSpeeds_SetDefaultSpeedPercentages(double motor1_speed
 	DC_motor2_default_speed = motor2_speed;
 }
 
-void CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_directions direction, double motor1_speed, double motor2_speed){
+void CAR_MOVEMENT_DifferentSpeeds_SetCallBacks(CAR_directions direction){
 	switch (direction){
 	case CAR_FORWARD:
-		TIMER_Timer1_OCA_SetCallBack(CAR_MOVEMENT_Low);
-		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Forward_FullSpeed);
-		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
-		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Forward_FullSpeed);
+		TIMER_Timer1_OCA_SetCallBack(CAR_MOVEMENT_Motor1_Low);
+		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Motor1_Forward_FullSpeed);
+		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Motor2_Low);
+		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Motor2_Forward_FullSpeed);
 		break;
 	case CAR_BACKWARD:
-		TIMER_Timer1_OCA_SetCallBack(CAR_MOVEMENT_Low);
-		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Backward_FullSpeed);
-		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
-		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Backward_FullSpeed);
+		TIMER_Timer1_OCA_SetCallBack(CAR_MOVEMENT_Motor1_Low);
+		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Motor1_Backward_FullSpeed);
+		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Motor2_Low);
+		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Motor2_Backward_FullSpeed);
 		break;
 	case CAR_RIGHT:
-		TIMER_Timer1_OCA_SetCallBack(CAR_MOVEMENT_Low);
-		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Right_FullSpeed);
-		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
-		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Right_FullSpeed);
+		TIMER_Timer1_OCA_SetCallBack(CAR_MOVEMENT_Motor1_Low);
+		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Motor1_Right_FullSpeed);
+		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Motor2_Low);
+		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Motor2_Right_FullSpeed);
 		break;
 	case CAR_LEFT:
-		TIMER_Timer1_OCA_SetCallBack(CAR_MOVEMENT_Low);
-		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Left_FullSpeed);
-		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
-		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Left_FullSpeed);
+		TIMER_Timer1_OCA_SetCallBack(CAR_MOVEMENT_Motor1_Low);
+		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Motor1_Left_FullSpeed);
+		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Motor2_Low);
+		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Motor2_Left_FullSpeed);
 		break;
 	}
+	DC_motors_direction = direction;
+}
+
+void CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_directions direction, double motor1_speed, double motor2_speed){
+	CAR_MOVEMENT_DifferentSpeeds_SetCallBacks(direction);
 	CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(motor1_speed, motor2_speed);
 }
 
+void CAR_MOVEMENT_DifferentSpeeds_ApplyDefaultSpeeds(void){
+	if (DC_motor1_speed_table && DC_motor2_speed_table){
+		// The tables already match the motors, so both are given the mean of the two manually matched speeds.
+		CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages((DC_motor1_default_speed + DC_motor2_default_speed) / 2.0, (DC_motor1_default_speed + DC_motor2_default_speed) / 2.0);
+	}
+	else{
+		CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(DC_motor1_default_speed, DC_motor2_default_speed);
+	}
+}
+
+/* Calibration */
+void CAR_MOVEMENT_SetSpeedTables(const u16_t* motor1_table, const u16_t* motor2_table){
+	DC_motor1_speed_table = motor1_table;
+	DC_motor2_speed_table = motor2_table;
+	if (motor1_table && motor2_table){
+		DC_motors_top_speed = motor1_table[CAR_SPEED_TABLE_POINTS - 1];
+		if (motor2_table[CAR_SPEED_TABLE_POINTS - 1] < DC_motors_top_speed){
+			DC_motors_top_speed = motor2_table[CAR_SPEED_TABLE_POINTS - 1];
+		}
+	}
+	CAR_MOVEMENT_BuildLinearization();
+}
+
+void CAR_MOVEMENT_SetDeadBands(u8_t motor1_dead_band, u8_t motor2_dead_band){
+	DC_motor1_dead_band = motor1_dead_band;
+	DC_motor2_dead_band = motor2_dead_band;
+	CAR_MOVEMENT_BuildLinearization();
+}
+
+void CAR_MOVEMENT_BuildLinearization(void){
+	u8_t i;
+	u16_t motor1_start = (u16_t) DC_motor1_dead_band * 255 / 100;		// OCR value of the dead band.
+	u16_t motor2_start = (u16_t) DC_motor2_dead_band * 255 / 100;
+	for (i = 0; i < CAR_SPEED_TABLE_POINTS; i++){
+		if (DC_motor1_speed_table && DC_motor2_speed_table){
+			// The measured curves already include the dead band, so the speed is only converted into a duty cycle.
+			DC_motor1_linearization[i] = CAR_MOVEMENT_SpeedToDuty(DC_motor1_speed_table, i * CAR_SPEED_TABLE_STEP);
+			DC_motor2_linearization[i] = CAR_MOVEMENT_SpeedToDuty(DC_motor2_speed_table, i * CAR_SPEED_TABLE_STEP);
+		}
+		else{
+			// The range above the dead band is spread over the whole speed range, so the smallest speed still turns the wheel.
+			DC_motor1_linearization[i] = motor1_start + (u16_t) i * (255 - motor1_start) / (CAR_SPEED_TABLE_POINTS - 1);
+			DC_motor2_linearization[i] = motor2_start + (u16_t) i * (255 - motor2_start) / (CAR_SPEED_TABLE_POINTS - 1);
+		}
+	}
+}
+
+u8_t CAR_MOVEMENT_Linearize(const u8_t* breakpoints, double speed){
+	u8_t percentage = (speed >= 100) ? 100 : (u8_t) speed;
+	u8_t i = percentage / CAR_SPEED_TABLE_STEP;
+	if (percentage == 0){
+		return 0;
+	}
+	if (i == CAR_SPEED_TABLE_POINTS - 1){
+		return breakpoints[i];
+	}
+	// Linear interpolation between the two breakpoints around the speed (the curve may fall in a flat part, so it is signed).
+	return breakpoints[i] + ((s16_t) breakpoints[i + 1] - breakpoints[i]) * (percentage % CAR_SPEED_TABLE_STEP) / CAR_SPEED_TABLE_STEP;
+}
+
+u8_t CAR_MOVEMENT_SpeedToDuty(const u16_t* table, u8_t speed){
+	u32_t target = (u32_t) speed * DC_motors_top_speed / 100;		// Required wheel speed in mm/s.
+	u8_t i;
+	if (target == 0){
+		target = 1;							// The slowest speed that still turns the wheel.
+	}
+	for (i = 1; i < CAR_SPEED_TABLE_POINTS - 1 && table[i] < target; i++);
+	if (table[i] <= table[i - 1]){			// Flat part of the curve (e.g. the motor does not turn yet).
+		return (u16_t) i * CAR_SPEED_TABLE_STEP * 255 / 100;
+	}
+	if (target > table[i]){
+		return 255;
+	}
+	// Linear interpolation between the two duty points around the target speed, in OCR counts (255 for 100%).
+	return ((u32_t) (i - 1) * (table[i] - table[i - 1]) + (target - table[i - 1])) * CAR_SPEED_TABLE_STEP * 255 / (100 * (u32_t) (table[i] - table[i - 1]));
+}
+
+/* Steering */
+u8_t CAR_MOVEMENT_Drive(s8_t speed, s16_t curvature){
+	s32_t difference;
+	s32_t motor1_speed;
+	s32_t motor2_speed;
+	s32_t fastest;
+	CAR_directions direction;
+	/*
+	 * NOTE:
+	 * 		The right wheel (motor 1) moves along a circle of radius (R + W / 2) and the left wheel (motor 2) along (R - W / 2),
+	 * 		where R = 1 / curvature and W is the wheel base. So each wheel speed is speed * (1 +- curvature * W / 2).
+	 * 		The curvature is in 1/km, so (curvature * W / 2) is divided by 1,000,000 to be in 1/mm.
+	 *
+	 */
+	difference = (s32_t) speed * curvature * CAR_WHEEL_BASE_MM_ / 2000000;
+	motor1_speed = speed + difference;
+	motor2_speed = speed - difference;
+	// If a wheel would exceed 100%, both wheels are scaled down by the same ratio to keep the curvature.
+	fastest = (motor1_speed < 0) ? -motor1_speed : motor1_speed;
+	if (((motor2_speed < 0) ? -motor2_speed : motor2_speed) > fastest){
+		fastest = (motor2_speed < 0) ? -motor2_speed : motor2_speed;
+	}
+	if (fastest > 100){
+		motor1_speed = motor1_speed * 100 / fastest;
+		motor2_speed = motor2_speed * 100 / fastest;
+	}
+	if (DC_motors_speed_mode == CAR_DC_MOTORS_SAME_SPEED){
+		// Timer2 alone cannot give the two wheels different speeds, so only straight movement is possible.
+		if (motor1_speed != motor2_speed){
+			return 0;
+		}
+		if (speed == 0){
+			CAR_MOVEMENT_Stop();
+		}
+		else{
+			CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage((speed > 0) ? CAR_FORWARD : CAR_BACKWARD, (speed > 0) ? speed : -speed);
+		}
+		return 1;
+	}
+	// The signs of the two wheels are exactly what forward, backward, right and left mean for each motor.
+	if (motor1_speed >= 0){
+		direction = (motor2_speed >= 0) ? CAR_FORWARD : CAR_LEFT;
+	}
+	else{
+		direction = (motor2_speed >= 0) ? CAR_RIGHT : CAR_BACKWARD;
+	}
+	CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(direction, (motor1_speed < 0) ? -motor1_speed : motor1_speed, (motor2_speed < 0) ? -motor2_speed : motor2_speed);
+	return 1;
+}
+
 
   /******************************************************************/
  /*************************** Direction ****************************/
 /******************************************************************/
 
 void CAR_MOVEMENT_Forward(void){
+	DC_motors_direction = CAR_FORWARD;
 	switch (DC_motors_speed_mode){
 	case CAR_DC_MOTORS_SAME_SPEED:
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
@@ -171,12 +453,13 @@ void CAR_MOVEMENT_Forward(void){
 		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Motor1_Forward_FullSpeed);
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Motor2_Low);
 		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Motor2_Forward_FullSpeed);
-		CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(DC_motor1_default_speed, DC_motor2_default_speed);
+		CAR_MOVEMENT_DifferentSpeeds_ApplyDefaultSpeeds();
 		break;
 	}
 }
 
 void CAR_MOVEMENT_Backward(void){
+	DC_motors_direction = CAR_BACKWARD;
 	switch (DC_motors_speed_mode){
 	case CAR_DC_MOTORS_SAME_SPEED:
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
@@ -188,12 +471,13 @@ void CAR_MOVEMENT_Backward(void){
 		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Motor1_Backward_FullSpeed);
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Motor2_Low);
 		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Motor2_Backward_FullSpeed);
-		CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(DC_motor1_default_speed, DC_motor2_default_speed);
+		CAR_MOVEMENT_DifferentSpeeds_ApplyDefaultSpeeds();
 		break;
 	}
 }
 
 void CAR_MOVEMENT_Right(void){
+	DC_motors_direction = CAR_RIGHT;
 	switch (DC_motors_speed_mode){
 	case CAR_DC_MOTORS_SAME_SPEED:
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
@@ -205,12 +489,13 @@ void CAR_MOVEMENT_Right(void){
 		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Motor1_Right_FullSpeed);
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Motor2_Low);
 		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Motor2_Right_FullSpeed);
-		CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(DC_motor1_default_speed, DC_motor2_default_speed);
+		CAR_MOVEMENT_DifferentSpeeds_ApplyDefaultSpeeds();
 		break;
 	}
 }
 
 void CAR_MOVEMENT_Left(void){
+	DC_motors_direction = CAR_LEFT;
 	switch (DC_motors_speed_mode){
 	case CAR_DC_MOTORS_SAME_SPEED:
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Low);
@@ -222,29 +507,25 @@ void CAR_MOVEMENT_Left(void){
 		TIMER_Timer1_IC_SetCallBack(CAR_MOVEMENT_Motor1_Left_FullSpeed);
 		TIMER_Timer2_OC_SetCallBack(CAR_MOVEMENT_Motor2_Low);
 		TIMER_Timer2_OV_SetCallBack(CAR_MOVEMENT_Motor2_Left_FullSpeed);
-		CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(DC_motor1_default_speed, DC_motor2_default_speed);
+		CAR_MOVEMENT_DifferentSpeeds_ApplyDefaultSpeeds();
 		break;
 	}
 }
 
 void CAR_MOVEMENT_Forward_FullSpeed(void){
-	H_BRIDGE_L293_Motor_CW(H_EN1, H_A1, H_A2);
-	H_BRIDGE_L293_Motor_CCW(H_EN2, H_A3, H_A4);
+	H_BRIDGE_L293_SetBoth(H_BRIDGE_CW, H_BRIDGE_CCW);
 }
 
 void CAR_MOVEMENT_Backward_FullSpeed(void){
-	H_BRIDGE_L293_Motor_CCW(H_EN1, H_A1, H_A2);
-	H_BRIDGE_L293_Motor_CW(H_EN2, H_A3, H_A4);
+	H_BRIDGE_L293_SetBoth(H_BRIDGE_CCW, H_BRIDGE_CW);
 }
 
 void CAR_MOVEMENT_Right_FullSpeed(void){
-	H_BRIDGE_L293_Motor_CCW(H_EN1, H_A1, H_A2);
-	H_BRIDGE_L293_Motor_CCW(H_EN2, H_A3, H_A4);
+	H_BRIDGE_L293_SetBoth(H_BRIDGE_CCW, H_BRIDGE_CCW);
 }
 
 void CAR_MOVEMENT_Left_FullSpeed(void){
-	H_BRIDGE_L293_Motor_CW(H_EN1, H_A1, H_A2);
-	H_BRIDGE_L293_Motor_CW(H_EN2, H_A3, H_A4);
+	H_BRIDGE_L293_SetBoth(H_BRIDGE_CW, H_BRIDGE_CW);
 }
 
 void CAR_MOVEMENT_Motor1_Forward_FullSpeed(void){
@@ -8,6 +8,49 @@
 #ifndef HAL_CAR_MOVEMENT_MOVEMENT_H_
 #define HAL_CAR_MOVEMENT_MOVEMENT_H_
 
+/* Car Geometry */
+/*
+ * NOTE:
+ * 		Motor 1 drives the right wheel and motor 2 drives the left wheel (CAR_MOVEMENT_Right_FullSpeed() runs motor 1 backward and motor 2 forward).
+ * 		These values were measured on our chassis. You may need to change them in your case.
+ *
+ */
+#define CAR_WHEEL_BASE_MM_						130		// Distance between the centers of the two wheels.
+#define CAR_MAXIMUM_WHEEL_SPEED_MM_PER_S_		400		// Wheel speed when its motor runs at 100%.
+
+/* Speed Tables */
+#define CAR_SPEED_TABLE_POINTS					11		// Wheel speed is measured at duty cycles 0%, 10%, 20%, ..., 100%.
+#define CAR_SPEED_TABLE_STEP					10
+
+/* Linearization */
+/*
+ * NOTE:
+ * 		Each motor has CAR_SPEED_TABLE_POINTS breakpoints that give the OCR value at speeds 0+%, 10%, ..., 100%, built from its
+ * 		speed table when calibrated, or from its dead band otherwise (22 bytes of RAM for both). The speeds between them are
+ * 		interpolated with integers. They are used only in the different speeds mode, since both motors share OCR2 otherwise.
+ * 		The default dead band is 0% (raw duty cycles), since the speeds used by the application were tuned on raw duty cycles.
+ *
+ */
+#define CAR_MOTOR_DEAD_BAND_DEFAULT				0		// Duty cycle (%) below which the wheels do not turn (about 30% on our chassis).
+
+/* PWM Phase */
+#define CAR_PWM_PHASE_OFFSET					128		// Timer1 starts this many counts ahead of Timer2 in different speeds mode (half a period).
+
+/* PWM Frequencies */
+/*
+ * NOTE:
+ * 		Timer2 has a fixed top of 255 in fast PWM mode, so the frequency is chosen only by the prescaler (F_CPU / (256 * prescaler)).
+ * 		No prescaler (62.5kHz) is not offered, since the PWM pins are driven from the ISRs, which cannot run every 256 cycles.
+ *
+ */
+typedef enum{
+	CAR_PWM_7812_HZ,			// Prescaler 8.
+	CAR_PWM_976_HZ,				// Prescaler 64 (default).
+	CAR_PWM_244_HZ,				// Prescaler 256.
+	CAR_PWM_61_HZ,				// Prescaler 1024.
+	CAR_PWM_FREQUENCIES
+} CAR_pwm_frequency;
+
 typedef enum{
 	CAR_DC_MOTORS_SAME_SPEED,
 	CAR_DC_MOTORS_DIFFERENT_SPEEDS
@@ -21,10 +64,18 @@ typedef enum{
 } CAR_directions;
 
 void CAR_MOVEMENT_Motors_Init(CAR_motors_speed_mode mode);
+CAR_motors_speed_mode CAR_MOVEMENT_GetSpeedMode(void);
+u8_t CAR_MOVEMENT_SetSpeedMode(CAR_motors_speed_mode mode);
+void CAR_MOVEMENT_SetPwmFrequency(CAR_pwm_frequency frequency);
+CAR_pwm_frequency CAR_MOVEMENT_GetPwmFrequency(void);
 void CAR_MOVEMENT_Low(void);
 void CAR_MOVEMENT_Motor1_Low(void);
 void CAR_MOVEMENT_Motor2_Low(void);
 void CAR_MOVEMENT_Stop(void);
+void CAR_MOVEMENT_StallHandler(void);
+void CAR_MOVEMENT_SetCommand(CAR_directions direction, double motor1_speed, double motor2_speed);
+s8_t CAR_MOVEMENT_Motor1_GetSpeed(void);
+s8_t CAR_MOVEMENT_Motor2_GetSpeed(void);
 
 /*
  * .-----------------------------.
@@ -41,11 +92,61 @@ void CAR_MOVEMENT_Stop(void);
  *
  *	____________________________________________________________________________________
 
+ *	CAR_MOVEMENT_GetSpeedMode(void):
+ * 				@brief	Get the speed mode that the motors are running in.
+ *
+ * 				@return CAR_motors_speed_mode
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_SetSpeedMode(CAR_motors_speed_mode mode):
+ * 				@brief	Switch between the same speed and the different speeds modes, even while the car moves.
+ *
+ * 				@details
+ * 						- Switching to CAR_DC_MOTORS_SAME_SPEED stops Timer1, so it can be used by the servo while the car keeps moving
+ * 						  at the mean speed of both motors.
+ * 						- Switching to CAR_DC_MOTORS_DIFFERENT_SPEEDS takes Timer1 again, so it is refused while SERVO_IsMoving()
+ * 						  (try again once the servo is centered). Each motor goes back to its own speed in the current direction.
+ * 						- The same speed mode gives the raw duty cycle, while the different speeds mode maps each motor through its
+ * 						  linearization breakpoints. So with a dead band or speed tables set, the wheel speed changes in a step
+ * 						  at the switch although the command stays the same.
+ * 						- Only the compare values and the callbacks are changed, with interrupts disabled, and TIMER_Timer2_Init()
+ * 						  is not called, so Timer2 keeps counting and its current period is not cut.
+ * 						- Timer1 is started by moving only TCNT1 after TCNT2 (with phase alignment), so the offset may be a few
+ * 						  counts off CAR_PWM_PHASE_OFFSET until the motors start again after a stop.
+ *
+ * 				@param mode: The new speed mode.
+ *
+ * 				@return 1 if the motors are in the new mode, 0 if the switch is refused.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_SetPwmFrequency(CAR_pwm_frequency frequency):
+ * 				@brief	Select the PWM frequency of the drive motors.
+ *
+ * 				@details
+ * 						- It is used the next time a speed is set (e.g. by CAR_MOVEMENT_Forward()), and the timers are synchronized again.
+ * 						- Both Timer1 and Timer2 use the same frequency. Timer0 (system tick) keeps its prescaler, but it shares the
+ * 						  prescaler reset with Timer1, so the tick may shift by up to one prescaler period on each synchronization.
+ * 						- The speed tables of CAR_CALIBRATION are measured at one frequency, so they should be measured again after changing it.
+ *
+ * 				@param frequency: The PWM frequency (7812, 976, 244 or 61Hz).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_GetPwmFrequency(void):
+ * 				@brief	Get the selected PWM frequency.
+ *
+ * 				@return CAR_pwm_frequency
+ *
+ *	____________________________________________________________________________________
+
  *	CAR_MOVEMENT_Low(void):
  * 				@brief	Stop both DC motors quickly.
  *
  * 				@details
  * 						- Sets both motor control pins to fast stop mode.
+ * 						- Both motors are switched at the same instant by H_BRIDGE_L293_SetBoth().
  *
  *	____________________________________________________________________________________
 
@@ -75,6 +176,34 @@ void CAR_MOVEMENT_Stop(void);
  *
  *	____________________________________________________________________________________
 
+ *	CAR_MOVEMENT_StallHandler(void):
+ * 				@brief	Cut the duty of both motors when a wheel is jammed.
+ *
+ * 				@details
+ * 						- To be set as the stall callback of CAR_CURRENT. It stops the car like CAR_MOVEMENT_Stop().
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_SetCommand(CAR_directions direction, double motor1_speed, double motor2_speed):
+ * 				@brief	Save the direction and the speed that each motor is driven with.
+ *
+ * 				@details
+ * 						- It is called by the speed functions, so there is no need to call it from the application.
+ * 						- The saved speeds are read by other modules (e.g. odometry) from the timer interrupts.
+ *
+ * 				@param direction: Direction of movement (forward, backward, right, left).
+ * 				@param motor1_speed: Speed percentage for motor 1 (0 to 100%).
+ * 				@param motor2_speed: Speed percentage for motor 2 (0 to 100%).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_Motor1_GetSpeed(void), CAR_MOVEMENT_Motor2_GetSpeed(void):
+ * 				@brief	Get the signed speed percentage that the motor is driven with now.
+ *
+ * 				@return s8_t (-100 to 100%), positive when the wheel moves the car forward and 0 when the car is stopped.
+ *
+ *	____________________________________________________________________________________
+
  */
 
   /******************************************************************/
@@ -82,8 +211,10 @@ void CAR_MOVEMENT_Stop(void);
 /******************************************************************/
 
  /* Controlling motors having the same speed */
+void CAR_MOVEMENT_SameSpeed_SetDuty(double speed);
 void CAR_MOVEMENT_SameSpeed_SetSpeedPercentage(double speed);
 void CAR_MOVEMENT_SameSpeed_SetDefaultSpeedPercentage(double speed);
+void CAR_MOVEMENT_SameSpeed_SetCallBacks(CAR_directions direction);
 void CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage(CAR_directions direction, double speed_percentage);
 
 /*
@@ -91,12 +222,23 @@ void CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage(CAR_directions direc
  * |Explanation of each function |
  * '-----------------------------'
 
+ *	CAR_MOVEMENT_SameSpeed_SetDuty(double speed):
+ * 				@brief	Set OCR2 and the command of both motors, without touching the state of Timer2.
+ *
+ * 				@details
+ * 						- Used alone to change the speed while Timer2 is running (e.g. by CAR_MOVEMENT_SetSpeedMode()).
+ *
+ * 				@param speed: Desired speed percentage (0 to 100%).
+ *
+ *	____________________________________________________________________________________
+
  *	CAR_MOVEMENT_SameSpeed_SetSpeedPercentage(double speed):
  * 				@brief	Set the speed percentage for both motors when running at the same speed.
  *
  * 				@details
  * 						- Configures Timer2 for PWM to control the speed of both motors.
  * 						- Adjusts the speed based on the given percentage.
+ * 						- The speed is a raw duty cycle, since both motors share OCR2 (the linearization is not used).
  *
  * 				@param speed: Desired speed percentage (0 to 100%).
  *
@@ -112,6 +254,13 @@ void CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage(CAR_directions direc
  *
  *	____________________________________________________________________________________
 
+ *	CAR_MOVEMENT_SameSpeed_SetCallBacks(CAR_directions direction):
+ * 				@brief	Set the Timer2 callbacks of the direction when running at the same speed.
+ *
+ * 				@param direction: Direction of movement (forward, backward, right, left).
+ *
+ *	____________________________________________________________________________________
+
  *	CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage(CAR_directions direction, double speed):
  * 				@brief	Set the direction and speed for both motors when running at the same speed.
  *
@@ -127,21 +276,34 @@ void CAR_MOVEMENT_SameSpeed_SetDirection_SetSpeedPercentage(CAR_directions direc
  */
 
 /* Controlling motors having different speeds */
+void CAR_MOVEMENT_DifferentSpeeds_SetDuties(double motor1_speed, double motor2_speed);
 void CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(double motor1_speed, double motor2_speed);
 void CAR_MOVEMENT_DifferentSpeeds_SetDefaultSpeedPercentages(double motor1_speed, double motor2_speed);
+void CAR_MOVEMENT_DifferentSpeeds_SetCallBacks(CAR_directions direction);
 void CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_directions direction, double motor1_speed, double motor2_speed);
+void CAR_MOVEMENT_DifferentSpeeds_ApplyDefaultSpeeds(void);
+void CAR_MOVEMENT_SetPhaseAlignment(u8_t enabled);
 
 /*
  * .-----------------------------.
  * |Explanation of each function |
  * '-----------------------------'
 
+ *	CAR_MOVEMENT_DifferentSpeeds_SetDuties(double motor1_speed, double motor2_speed):
+ * 				@brief	Set ICR1, OCR1A, OCR2 and the command of each motor, without touching the state of the timers.
+ *
+ * 				@param motor1_speed: Speed percentage for motor 1 (0 to 100%).
+ * 				@param motor2_speed: Speed percentage for motor 2 (0 to 100%).
+ *
+ *	____________________________________________________________________________________
+
  *	CAR_MOVEMENT_DifferentSpeeds_SetSpeedPercentages(double motor1_speed, double motor2_speed):
  * 				@brief	Set different speed percentages for each motor.
  *
  * 				@details
  * 						- Configures Timer1 and Timer2 for PWM to control the speed of each motor separately.
  * 						- Sets the top values for Timer1 and Timer2 to handle 8-bit PWM.
+ * 						- When the motors start, both timers are synchronized with Timer1 half a period ahead (CAR_PWM_PHASE_OFFSET).
  *
  * 				@param motor1_speed: Speed percentage for motor 1 (0 to 100%).
  * 				@param motor2_speed: Speed percentage for motor 2 (0 to 100%).
@@ -159,6 +321,13 @@ void CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_direction
  *
  *	____________________________________________________________________________________
 
+ *	CAR_MOVEMENT_DifferentSpeeds_SetCallBacks(CAR_directions direction):
+ * 				@brief	Set the Timer1 and Timer2 callbacks of the direction when running at different speeds.
+ *
+ * 				@param direction: Direction of movement (forward, backward, right, left).
+ *
+ *	____________________________________________________________________________________
+
  *	CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_directions direction, double motor1_speed, double motor2_speed):
  * 				@brief	Set the direction and speed for each motor when running at different speeds.
  *
@@ -172,6 +341,128 @@ void CAR_MOVEMENT_DifferentSpeeds_SetDirection_SetSpeedPercentages(CAR_direction
  *
  *	____________________________________________________________________________________
 
+ *	CAR_MOVEMENT_SetPhaseAlignment(u8_t enabled):
+ * 				@brief	Enable or disable starting Timer1 and Timer2 in phase (enabled by default).
+ *
+ * 				@details
+ * 						- When disabled, the timers start one after the other with a random phase between them, as before.
+ * 						- Meant to compare the ISR latencies with TIMER_PROFILE_LATENCY (not measured on the board yet).
+ * 						- It takes effect the next time the motors start after a stop.
+ *
+ * 				@param enabled: 1 to align the timers, 0 otherwise.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_DifferentSpeeds_ApplyDefaultSpeeds(void):
+ * 				@brief	Run the motors with their default speeds.
+ *
+ * 				@details
+ * 						- If speed tables are set, both motors take the mean of the two default speeds, since the tables match them.
+ * 						- Otherwise, each motor takes its own default speed percentage (e.g. 54% and 50%).
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+/* Calibration */
+void CAR_MOVEMENT_SetSpeedTables(const u16_t* motor1_table, const u16_t* motor2_table);
+u8_t CAR_MOVEMENT_SpeedToDuty(const u16_t* table, u8_t speed);
+void CAR_MOVEMENT_SetDeadBands(u8_t motor1_dead_band, u8_t motor2_dead_band);
+void CAR_MOVEMENT_BuildLinearization(void);
+u8_t CAR_MOVEMENT_Linearize(const u8_t* breakpoints, double speed);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	CAR_MOVEMENT_SetSpeedTables(const u16_t* motor1_table, const u16_t* motor2_table):
+ * 				@brief	Set the duty -> speed tables measured for each motor (e.g. by CAR_CALIBRATION).
+ *
+ * 				@details
+ * 						- Each table has CAR_SPEED_TABLE_POINTS wheel speeds (mm/s) at duty cycles 0%, 10%, ..., 100%.
+ * 						- Once set, the speed percentages in CAR_DC_MOTORS_DIFFERENT_SPEEDS mode mean a percentage of the top speed
+ * 						  that both motors can reach, so the same percentage gives the same wheel speed on both sides.
+ * 						- The tables are not copied, so they must stay in memory. Pass NULL to go back to raw duty cycles.
+ *
+ * 				@param motor1_table: Speed table of motor 1.
+ * 				@param motor2_table: Speed table of motor 2.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_SpeedToDuty(const u16_t* table, u8_t speed):
+ * 				@brief	Find the duty cycle that gives a speed according to a speed table.
+ *
+ * 				@details
+ * 						- Integer math only. A speed of 0% gives the duty cycle at which the wheel starts to turn.
+ *
+ * 				@param table: Speed table of the motor.
+ * 				@param speed: Speed percentage of the common top speed (0 to 100%).
+ *
+ * 				@return u8_t (0 to 255) OCR value of the duty cycle.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_SetDeadBands(u8_t motor1_dead_band, u8_t motor2_dead_band):
+ * 				@brief	Set the duty cycle below which each motor does not turn.
+ *
+ * 				@details
+ * 						- Any speed above 0% is mapped above the dead band, so low speeds (e.g. creeping near an obstacle) still move the car.
+ * 						- They are not used while the speed tables are set, since the tables already include the dead band.
+ *
+ * 				@param motor1_dead_band: Dead band of motor 1 (0 to 99%).
+ * 				@param motor2_dead_band: Dead band of motor 2 (0 to 99%).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_BuildLinearization(void):
+ * 				@brief	Build the linearization breakpoints of each motor from its speed table or its dead band.
+ *
+ * 				@details
+ * 						- It is called by CAR_MOVEMENT_Motors_Init(), CAR_MOVEMENT_SetSpeedTables() and CAR_MOVEMENT_SetDeadBands().
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_MOVEMENT_Linearize(const u8_t* breakpoints, double speed):
+ * 				@brief	Get the OCR value of a speed from the linearization breakpoints of a motor.
+ *
+ * 				@details
+ * 						- The speed is truncated to a whole percentage, and any speed above 0% is mapped from the first breakpoint (dead band).
+ *
+ * 				@param breakpoints: Linearization breakpoints of the motor.
+ * 				@param speed: Speed percentage (0 to 100%).
+ *
+ * 				@return u8_t (0 to 255) OCR value.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+/* Steering */
+u8_t CAR_MOVEMENT_Drive(s8_t speed, s16_t curvature);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	CAR_MOVEMENT_Drive(s8_t speed, s16_t curvature):
+ * 				@brief	Drive the car along an arc without stopping, forward or backward.
+ *
+ * 				@details
+ * 						- Calculates the speed of each wheel from the curvature and the wheel base (CAR_WHEEL_BASE_MM_).
+ * 						- If one wheel would need more than 100%, both speeds are scaled down so the arc stays the same.
+ * 						- A tight arc (radius less than half the wheel base) runs the inner wheel backward.
+ * 						- In CAR_DC_MOTORS_SAME_SPEED mode, only a zero curvature (straight movement) is possible.
+ *
+ * 				@param speed: Speed percentage of the center of the car (-100 to 100%), negative means backward.
+ * 				@param curvature: 1 / radius in 1/km (e.g. 2000 for a radius of 50 cm), and 0 means straight.
+ * 								  When positive, the center of the circle is on the left of the car whether it moves forward or backward.
+ *
+ * 				@return 1 if the car is driven, 0 if the arc is not possible in the current speed mode.
+ *
+ *	____________________________________________________________________________________
+
  */
 
   /******************************************************************/
@@ -241,6 +532,7 @@ void CAR_MOVEMENT_Motor2_Left_FullSpeed(void);
  *
  * 				@details
  * 						- Configures the H-Bridge to rotate motor 1 clockwise and motor 2 counterclockwise for forward movement.
+ * 						- Both motors are switched at the same instant by H_BRIDGE_L293_SetBoth().
  *
  *	____________________________________________________________________________________
 
@@ -249,6 +541,7 @@ void CAR_MOVEMENT_Motor2_Left_FullSpeed(void);
  *
  * 				@details
  * 						- Configures the H-Bridge to rotate motor 1 counterclockwise and motor 2 clockwise for backward movement.
+ * 						- Both motors are switched at the same instant by H_BRIDGE_L293_SetBoth().
  *
  *	____________________________________________________________________________________
 
@@ -257,6 +550,7 @@ void CAR_MOVEMENT_Motor2_Left_FullSpeed(void);
  *
  * 				@details
  * 						- Configures the H-Bridge to rotate both motors counterclockwise for a right turn.
+ * 						- Both motors are switched at the same instant by H_BRIDGE_L293_SetBoth().
  *
  *	____________________________________________________________________________________
 
@@ -265,6 +559,7 @@ void CAR_MOVEMENT_Motor2_Left_FullSpeed(void);
  *
  * 				@details
  * 						- Configures the H-Bridge to rotate both motors clockwise for a left turn.
+ * 						- Both motors are switched at the same instant by H_BRIDGE_L293_SetBoth().
  *
  *	____________________________________________________________________________________
 
@@ -0,0 +1,177 @@
+/*
+ * ODOMETRY.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../../../LIB/STD_TYPES.h"
+#include "../../../../LIB/BIT_MATH.h"
+#include "../../../../MCAL/INTERRUPT/INTERRUPT.h"
+#include "../../../../MCAL/TIMER/TICK/TICK.h"
+#include "../MOVEMENT/MOVEMENT.h"
+#include "ODOMETRY.h"
+
+/* Variables */
+u8_t odometry_source = CAR_ODOMETRY_COMMANDED_SPEED;
+volatile u8_t odometry_motor1_counts = 0;
+volatile u8_t odometry_motor2_counts = 0;
+volatile u16_t odometry_motor1_total_counts = 0;	// Counts since the initialization, not cleared by the pose update (wraps after 65535).
+volatile u16_t odometry_motor2_total_counts = 0;
+s32_t odometry_step_per_percent;				// Q16.16 millimeters a wheel moves in one tick for each 1% of speed.
+s32_t odometry_step_per_count;					// Q16.16 millimeters a wheel moves for each encoder count.
+s32_t odometry_angle_factor;					// Converts Q16.16 millimeters of wheels difference into heading (Q16.16 binary angle), multiplied by 16.
+volatile s32_t odometry_x = 0;
+volatile s32_t odometry_y = 0;
+volatile u32_t odometry_heading = 0;			// Binary angle as Q16.16, so small rotations in a tick are not lost.
+volatile u32_t odometry_travelled = 0;
+
+/* Quarter-wave sine table: sin(i * 90 / 64 degrees) as Q15 */
+const s16_t odometry_sine_table[65] = {
+		0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512,
+		10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204,
+		18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811, 25329,
+		25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956, 30273,
+		30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609,
+		32678, 32728, 32757, 32767
+};
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void CAR_ODOMETRY_Init(CAR_odometry_source source){
+	odometry_source = source;
+	/*
+	 * NOTE:
+	 * 		The conversion factors are calculated here once, so the tick only multiplies integers.
+	 * 		65536 converts millimeters into Q16.16, and 65536 / (2 * pi) converts radians into a binary angle.
+	 *
+	 */
+	odometry_step_per_percent = (s32_t) ((double) CAR_MAXIMUM_WHEEL_SPEED_MM_PER_S_ * TIMER_TICK_PERIOD_US_ * 65536 / 100000000);
+	odometry_step_per_count = (s32_t) (CAR_ODOMETRY_MM_PER_ENCODER_COUNT_ * 65536);
+	odometry_angle_factor = (s32_t) (16 * 65536 / (2 * 3.14159265 * CAR_WHEEL_BASE_MM_));
+	CAR_ODOMETRY_Reset();
+	TIMER_TICK_Init();
+	TIMER_TICK_AddCallBack(CAR_ODOMETRY_Update);
+}
+
+void CAR_ODOMETRY_Reset(void){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	odometry_x = 0;
+	odometry_y = 0;
+	odometry_heading = 0;
+	odometry_travelled = 0;
+	odometry_motor1_counts = 0;
+	odometry_motor2_counts = 0;
+	SREG = sreg;
+}
+
+void CAR_ODOMETRY_GetPose(CAR_pose* pose){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	pose->x = odometry_x;
+	pose->y = odometry_y;
+	pose->heading = (u16_t) (odometry_heading >> 16);
+	pose->travelled = odometry_travelled;
+	SREG = sreg;
+}
+
+s16_t CAR_ODOMETRY_Sin(u16_t angle){
+	u16_t quarter_angle = angle & 0x3FFF;
+	u8_t index;
+	s16_t value;
+	if (GET_BIT(angle, 14)){						// Second and fourth quarters are the mirror of the first one.
+		quarter_angle = 0x4000 - quarter_angle;
+	}
+	index = quarter_angle >> 8;
+	if (index == 64){
+		value = odometry_sine_table[64];
+	}
+	else{
+		value = odometry_sine_table[index] + (s16_t) (((s32_t) (odometry_sine_table[index + 1] - odometry_sine_table[index]) * (quarter_angle & 0xFF)) >> 8);
+	}
+	return (GET_BIT(angle, 15)) ? -value : value;	// Third and fourth quarters are negative.
+}
+
+s16_t CAR_ODOMETRY_Cos(u16_t angle){
+	return CAR_ODOMETRY_Sin(angle + 0x4000);		// cos(angle) = sin(angle + 90)
+}
+
+void CAR_ODOMETRY_Motor1_EncoderHandler(void){
+	odometry_motor1_counts++;
+	odometry_motor1_total_counts++;
+}
+
+void CAR_ODOMETRY_Motor2_EncoderHandler(void){
+	odometry_motor2_counts++;
+	odometry_motor2_total_counts++;
+}
+
+u16_t CAR_ODOMETRY_Motor1_GetTotalCounts(void){
+	u16_t counts;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	counts = odometry_motor1_total_counts;
+	SREG = sreg;
+	return counts;
+}
+
+u16_t CAR_ODOMETRY_Motor2_GetTotalCounts(void){
+	u16_t counts;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	counts = odometry_motor2_total_counts;
+	SREG = sreg;
+	return counts;
+}
+
+void CAR_ODOMETRY_Update(void){
+	s32_t motor1_step;								// Right wheel.
+	s32_t motor2_step;								// Left wheel.
+	s32_t distance;
+	s32_t rotation;
+	u16_t heading;
+	switch (odometry_source){
+	case CAR_ODOMETRY_COMMANDED_SPEED:
+		motor1_step = CAR_MOVEMENT_Motor1_GetSpeed() * odometry_step_per_percent;
+		motor2_step = CAR_MOVEMENT_Motor2_GetSpeed() * odometry_step_per_percent;
+		break;
+	default:
+		/*
+		 * NOTE:
+		 * 		Single channel encoders count in both directions, so the sign is taken from the commanded direction.
+		 * 		This runs inside the Timer0 ISR, so the encoder ISRs cannot change the counts between reading and clearing them.
+		 *
+		 */
+		motor1_step = odometry_motor1_counts * odometry_step_per_count;
+		motor2_step = odometry_motor2_counts * odometry_step_per_count;
+		odometry_motor1_counts = 0;
+		odometry_motor2_counts = 0;
+		if (CAR_MOVEMENT_Motor1_GetSpeed() < 0){
+			motor1_step = -motor1_step;
+		}
+		if (CAR_MOVEMENT_Motor2_GetSpeed() < 0){
+			motor2_step = -motor2_step;
+		}
+		break;
+	}
+	if (motor1_step == 0 && motor2_step == 0){
+		return;
+	}
+	distance = (motor1_step + motor2_step) / 2;
+	rotation = ((motor1_step - motor2_step) * odometry_angle_factor) >> 4;
+	/*
+	 * NOTE:
+	 * 		The car is assumed to move along the heading in the middle of the tick, which is exact for arcs.
+	 * 		The distance is shifted to Q8 before multiplying by the Q15 sine, so the product fits in 32 bits.
+	 *
+	 */
+	heading = (u16_t) ((odometry_heading + (rotation / 2)) >> 16);
+	odometry_x += ((distance >> 8) * CAR_ODOMETRY_Cos(heading)) >> 7;
+	odometry_y += ((distance >> 8) * CAR_ODOMETRY_Sin(heading)) >> 7;
+	odometry_heading += rotation;
+	odometry_travelled += (distance < 0) ? -distance : distance;
+}
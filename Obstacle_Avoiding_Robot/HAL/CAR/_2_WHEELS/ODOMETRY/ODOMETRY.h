@@ -0,0 +1,134 @@
+/*
+ * ODOMETRY.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef HAL_CAR_ODOMETRY_ODOMETRY_H_
+#define HAL_CAR_ODOMETRY_ODOMETRY_H_
+
+/* Encoders */
+/*
+ * NOTE:
+ * 		Wheel encoders are optional. When they are not fitted, the pose is estimated from the speed that each motor is driven with.
+ * 		The encoder handlers must be registered by the application as callbacks of the external interrupts the encoders are wired to.
+ *
+ */
+#define CAR_ODOMETRY_MM_PER_ENCODER_COUNT_		1.0		// Distance a wheel moves between two encoder counts.
+
+/* Fixed-Point Formats */
+/*
+ * NOTE:
+ * 		- Positions are in millimeters as Q16.16 (the upper 16 bits are the integer part), so they range up to +-32 meters.
+ * 		- The heading is a binary angle where 65536 is a full turn (0 -> 0 degrees, 16384 -> 90 degrees, ...), so it wraps by itself.
+ * 		- The x axis points to where the car was facing on the last reset, and positive angles are counterclockwise (to the left).
+ *
+ */
+#define CAR_ODOMETRY_Q16_TO_MM(value)			((s16_t) ((value) >> 16))
+#define CAR_ODOMETRY_ANGLE_TO_DEGREES(angle)	((u16_t) (((u32_t) (angle) * 360) >> 16))
+#define CAR_ODOMETRY_DEGREES_TO_ANGLE(degrees)	((u16_t) (((u32_t) (degrees) << 16) / 360))
+
+/* Sources */
+typedef enum{
+	CAR_ODOMETRY_COMMANDED_SPEED,
+	CAR_ODOMETRY_ENCODERS
+} CAR_odometry_source;
+
+/* Pose */
+typedef struct{
+	s32_t x;				// Q16.16 millimeters.
+	s32_t y;				// Q16.16 millimeters.
+	u16_t heading;			// Binary angle.
+	u32_t travelled;		// Q16.16 millimeters moved by the center of the car in any direction (wraps after 65 meters).
+} CAR_pose;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void CAR_ODOMETRY_Init(CAR_odometry_source source);
+void CAR_ODOMETRY_Reset(void);
+void CAR_ODOMETRY_GetPose(CAR_pose* pose);
+s16_t CAR_ODOMETRY_Sin(u16_t angle);
+s16_t CAR_ODOMETRY_Cos(u16_t angle);
+void CAR_ODOMETRY_Motor1_EncoderHandler(void);
+void CAR_ODOMETRY_Motor2_EncoderHandler(void);
+u16_t CAR_ODOMETRY_Motor1_GetTotalCounts(void);
+u16_t CAR_ODOMETRY_Motor2_GetTotalCounts(void);
+void CAR_ODOMETRY_Update(void);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	CAR_ODOMETRY_Init(CAR_odometry_source source):
+ * 				@brief	Initialize the odometry and start integrating the pose from (0, 0) facing 0 degrees.
+ *
+ * 				@details
+ * 						- Starts the system tick if it is not running yet, and registers CAR_ODOMETRY_Update() as a tick callback.
+ *
+ * 				@param source: Where the wheels movement is taken from (commanded speed or encoders).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_ODOMETRY_Reset(void):
+ * 				@brief	Make the current position the origin and the current heading 0 degrees.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_ODOMETRY_GetPose(CAR_pose* pose):
+ * 				@brief	Copy the current pose.
+ *
+ * 				@details
+ * 						- Interrupts are disabled while copying, so x, y and the heading always come from the same tick.
+ *
+ * 				@param pose: Pointer to the structure to copy the pose into.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_ODOMETRY_Sin(u16_t angle), CAR_ODOMETRY_Cos(u16_t angle):
+ * 				@brief	Get the sine or the cosine of a binary angle.
+ *
+ * 				@details
+ * 						- Uses a quarter-wave table of 65 entries with linear interpolation between them.
+ *
+ * 				@param angle: Binary angle (65536 is a full turn).
+ *
+ * 				@return s16_t as Q15 (32767 is 1).
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_ODOMETRY_Motor1_EncoderHandler(void), CAR_ODOMETRY_Motor2_EncoderHandler(void):
+ * 				@brief	Count one encoder pulse of the motor.
+ *
+ * 				@details
+ * 						- To be set as the callback of the external interrupt that the encoder is connected to.
+ * 						- The direction of the count is taken from the direction the motor is driven in.
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_ODOMETRY_Motor1_GetTotalCounts(void), CAR_ODOMETRY_Motor2_GetTotalCounts(void):
+ * 				@brief	Get the number of encoder pulses of the motor since the initialization in any direction.
+ *
+ * 				@details
+ * 						- It wraps after 65535, so the difference between two readings is still right if it is taken as u16_t.
+ *
+ * 				@return u16_t
+ *
+ *	____________________________________________________________________________________
+
+ *	CAR_ODOMETRY_Update(void):
+ * 				@brief	Integrate the movement of the last tick into the pose.
+ *
+ * 				@details
+ * 						- It is called every tick from the Timer0 overflow interrupt, and takes the same time every tick.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* HAL_CAR_ODOMETRY_ODOMETRY_H_ */
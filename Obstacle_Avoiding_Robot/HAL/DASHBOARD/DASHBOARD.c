@@ -0,0 +1,270 @@
+/*
+ * DASHBOARD.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+#include "../../LIB/FLASH.h"
+#include "../../LIB/PIN_CONFIG.h"
+#include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/INTERRUPT/INTERRUPT.h"
+#include "../../MCAL/INTERRUPT/EXTERNAL/EXTERNAL.h"
+#include "../../MCAL/TIMER/TIMER.h"
+#include "../../MCAL/TIMER/TICK/TICK.h"
+#include "../LCD/LCD.h"
+#include "../ULTRASONIC/ULTRASONIC.h"
+#include "../CAR/_2_WHEELS/MOVEMENT/MOVEMENT.h"
+#include "../CAR/_2_WHEELS/CURRENT/CURRENT.h"
+#include "DASHBOARD.h"
+
+/* Linker Symbols */
+extern u8_t __heap_start;							// First free byte after the variables.
+
+/* Variables */
+u8_t dashboard_running = 0;
+u8_t dashboard_mode;
+u8_t dashboard_page = DASHBOARD_PAGE_LOOP;
+u8_t dashboard_field = UPPER_ROW;					// Row that is printed next.
+volatile u8_t dashboard_button_pressed = 0;
+u32_t dashboard_last_press = 0;
+u16_t dashboard_window_ticks = 0;
+u16_t dashboard_page_ticks = 0;
+u8_t dashboard_render_ticks = 0;
+u16_t dashboard_stack_painted = 0;				// Bytes filled with the pattern at start-up.
+u16_t dashboard_stack_free = 0;
+volatile u8_t dashboard_stack_requested = 0;		// Set by the tick when the main loop should count the free stack again.
+
+/* Measurements */
+volatile u8_t dashboard_loops = 0;					// Counted by the main loop, and only read by the tick (so it wraps).
+u8_t dashboard_last_loops = 0;
+u16_t dashboard_last_echoes = 0;
+u32_t dashboard_last_busy = 0;
+u8_t dashboard_loop_rate = 0;						// Loops per second.
+u16_t dashboard_ping_rate = 0;						// Echoes per second.
+u16_t dashboard_tick_load = 0;						// Per mille.
+
+/* Labels of each page (whole rows, with the units) */
+const char dashboard_label_loop_rate[] FLASH_SECTION =	"Loop rate     /s";
+const char dashboard_label_tick_load[] FLASH_SECTION =	"Tick ISR       %";
+const char dashboard_label_ping_rate[] FLASH_SECTION =	"Pings         /s";
+const char dashboard_label_timeouts[] FLASH_SECTION =	"Timeouts        ";
+const char dashboard_label_motor1[] FLASH_SECTION =		"Motor 1        %";
+const char dashboard_label_motor2[] FLASH_SECTION =		"Motor 2        %";
+const char dashboard_label_battery[] FLASH_SECTION =	"Battery        V";
+const char dashboard_label_stack[] FLASH_SECTION =		"Free stack     B";
+const char dashboard_label_reflex[] FLASH_SECTION =		"Reflex        us";
+const char dashboard_label_pwm_isr[] FLASH_SECTION =	"PWM late     cnt";
+
+const char dashboard_no_value[] FLASH_SECTION =		"--.--";
+
+const char* const dashboard_labels[DASHBOARD_PAGES][LCD_ROWS] FLASH_SECTION = {
+	{dashboard_label_loop_rate, dashboard_label_tick_load},
+	{dashboard_label_ping_rate, dashboard_label_timeouts},
+	{dashboard_label_motor1, dashboard_label_motor2},
+	{dashboard_label_battery, dashboard_label_stack},
+	{dashboard_label_reflex, dashboard_label_pwm_isr}
+};
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void DASHBOARD_PaintStack(void){
+	u8_t* byte = &__heap_start;
+	u8_t* top = (u8_t*) SP;						// Everything under the stack pointer is free now.
+	while (byte < top){
+		*byte = DASHBOARD_STACK_PATTERN;
+		byte++;
+	}
+	dashboard_stack_painted = top - &__heap_start;
+	dashboard_stack_free = dashboard_stack_painted;
+}
+
+void DASHBOARD_Init(DASHBOARD_cycle_mode mode){
+	dashboard_mode = mode;
+	dashboard_page = DASHBOARD_PAGE_LOOP;
+	dashboard_last_echoes = ULTRASONIC_GetEchoCount();
+	dashboard_last_busy = TIMER_TICK_GetBusyCounts();
+	DASHBOARD_DrawLabels();
+	DIO_SetPinDirection(DASHBOARD_BUTTON_PORT, DASHBOARD_BUTTON_PIN, PIN_INPUT);
+	DIO_EnablePinPullup(DASHBOARD_BUTTON_PORT, DASHBOARD_BUTTON_PIN);
+	INTERRUPT_EXTERNAL_INT0_ControlSense(INT0_INT1_FALLING_EDGE);
+	INTERRUPT_EXTERNAL_INT0_SetCallBack(DASHBOARD_Button_InterruptHandler);
+	INTERRUPT_EXTERNAL_INT0_EnableInterrupt();
+	LCD_StartBackgroundRefresh();
+	TIMER_TICK_Init();
+	TIMER_TICK_AddCallBack(DASHBOARD_Update);
+	dashboard_running = 1;
+}
+
+void DASHBOARD_CountLoop(void){
+	dashboard_loops++;
+}
+
+void DASHBOARD_MeasureStack(void){
+	u8_t* bottom = &__heap_start;
+	u16_t free = 0;
+	u8_t sreg;
+	if (!dashboard_stack_requested){
+		return;
+	}
+	dashboard_stack_requested = 0;
+	// The stack grows down toward the variables, so the free part is the run of pattern bytes right above them.
+	while (free < dashboard_stack_painted && bottom[free] == DASHBOARD_STACK_PATTERN){
+		free++;
+	}
+	sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();		// The tick reads both bytes.
+	dashboard_stack_free = free;
+	SREG = sreg;
+}
+
+void DASHBOARD_NextPage(void){
+	dashboard_page++;
+	if (dashboard_page == DASHBOARD_PAGES){
+		dashboard_page = DASHBOARD_PAGE_LOOP;
+	}
+	dashboard_page_ticks = 0;
+	dashboard_field = UPPER_ROW;
+	DASHBOARD_DrawLabels();
+}
+
+u16_t DASHBOARD_GetFreeStack(void){
+	return dashboard_stack_free;
+}
+
+void DASHBOARD_DrawLabels(void){
+	u8_t row;
+	for (row = 0; row < LCD_ROWS; row++){
+		LCD_GoToPosition(row, 0);
+		LCD_SendString_P((const char*) FLASH_ReadWord(&dashboard_labels[dashboard_page][row]));
+	}
+}
+
+void DASHBOARD_RenderField(u8_t row){
+	s8_t speed;
+	u16_t value;
+	switch (dashboard_page){
+	case DASHBOARD_PAGE_LOOP:
+		if (row == UPPER_ROW){
+			LCD_GoToPosition(UPPER_ROW, 10);
+			LCD_SendU16Padded(dashboard_loop_rate, 4);
+		}
+		else{
+			LCD_GoToPosition(LOWER_ROW, 10);
+			LCD_SendU16Padded(dashboard_tick_load / 10, 3);
+			LCD_SendChar('.');
+			LCD_SendChar('0' + dashboard_tick_load % 10);
+		}
+		break;
+
+	case DASHBOARD_PAGE_ULTRASONIC:
+		if (row == UPPER_ROW){
+			LCD_GoToPosition(UPPER_ROW, 10);
+			LCD_SendU16Padded(dashboard_ping_rate, 4);
+		}
+		else{
+			LCD_GoToPosition(LOWER_ROW, 11);
+			LCD_SendU16Padded(ULTRASONIC_GetTimeoutCount(), 5);
+		}
+		break;
+
+	case DASHBOARD_PAGE_MOTORS:
+		speed = (row == UPPER_ROW) ? CAR_MOVEMENT_Motor1_GetSpeed() : CAR_MOVEMENT_Motor2_GetSpeed();
+		LCD_GoToPosition(row, 11);
+		LCD_SendChar((speed < 0) ? '-' : ' ');
+		LCD_SendU16Padded((speed < 0) ? -speed : speed, 3);
+		break;
+
+	case DASHBOARD_PAGE_POWER:
+		if (row == UPPER_ROW && !DASHBOARD_BATTERY){
+			LCD_GoToPosition(UPPER_ROW, 10);
+			LCD_SendString_P(dashboard_no_value);
+		}
+		else if (row == UPPER_ROW){
+			value = CAR_CURRENT_GetBattery_mV_() / 10;			// Hundredths of a volt.
+			LCD_GoToPosition(UPPER_ROW, 10);
+			LCD_SendU16Padded(value / 100, 2);
+			LCD_SendChar('.');
+			LCD_SendChar('0' + value / 10 % 10);
+			LCD_SendChar('0' + value % 10);
+		}
+		else{
+			LCD_GoToPosition(LOWER_ROW, 11);
+			LCD_SendU16Padded(DASHBOARD_GetFreeStack(), 4);
+		}
+		break;
+
+	case DASHBOARD_PAGE_LATENCY:
+		if (row == UPPER_ROW){
+			LCD_GoToPosition(UPPER_ROW, 10);
+			LCD_SendU16Padded(ULTRASONIC_Reflex_GetWorstLatency_us_(), 4);
+		}
+		else{
+			LCD_GoToPosition(LOWER_ROW, 8);
+			LCD_SendU16Padded(DASHBOARD_GetWorstPwmLateness(), 4);
+		}
+		break;
+	}
+}
+
+u8_t DASHBOARD_GetWorstPwmLateness(void){
+	u8_t worst = 0;
+	u8_t isr;
+	for (isr = 0; isr < TIMER_PROFILED_ISRS; isr++){
+		if (TIMER_Profile_GetWorstLatency(isr) > worst){
+			worst = TIMER_Profile_GetWorstLatency(isr);
+		}
+	}
+	return worst;
+}
+
+void DASHBOARD_Measure(void){
+	u8_t loops = dashboard_loops;
+	u16_t echoes = ULTRASONIC_GetEchoCount();
+	u32_t busy = TIMER_TICK_GetBusyCounts();
+	// The counters wrap, so only their differences over the window are used.
+	dashboard_loop_rate = (u32_t) (u8_t) (loops - dashboard_last_loops) * DASHBOARD_WINDOW_MS_ / ((u32_t) dashboard_window_ticks * TIMER_TICK_PERIOD_US_ / 1000);
+	dashboard_ping_rate = (u32_t) (u16_t) (echoes - dashboard_last_echoes) * DASHBOARD_WINDOW_MS_ / ((u32_t) dashboard_window_ticks * TIMER_TICK_PERIOD_US_ / 1000);
+	dashboard_tick_load = (busy - dashboard_last_busy) * 1000 / ((u32_t) dashboard_window_ticks * TIMER_TICK_COUNTS_PER_TICK);
+	dashboard_last_loops = loops;
+	dashboard_last_echoes = echoes;
+	dashboard_last_busy = busy;
+}
+
+void DASHBOARD_Button_InterruptHandler(void){
+	u32_t now = TIMER_TICK_GetTicks();
+	if (now - dashboard_last_press >= TIMER_TICK_MS_TO_TICKS(DASHBOARD_DEBOUNCE_MS_)){
+		dashboard_button_pressed = 1;
+		dashboard_last_press = now;
+	}
+}
+
+void DASHBOARD_Update(void){
+	if (!dashboard_running){
+		return;
+	}
+	dashboard_window_ticks++;
+	if (dashboard_window_ticks >= TIMER_TICK_MS_TO_TICKS(DASHBOARD_WINDOW_MS_)){
+		DASHBOARD_Measure();
+		dashboard_window_ticks = 0;
+		dashboard_stack_requested = 1;
+	}
+	dashboard_page_ticks++;
+	if (dashboard_button_pressed || (dashboard_mode == DASHBOARD_AUTO_CYCLE && dashboard_page_ticks >= TIMER_TICK_MS_TO_TICKS(DASHBOARD_PAGE_MS_))){
+		dashboard_button_pressed = 0;
+		DASHBOARD_NextPage();
+		dashboard_render_ticks = TIMER_TICK_MS_TO_TICKS(DASHBOARD_RENDER_MS_);		// The values of the new page are printed at once.
+		return;
+	}
+	dashboard_render_ticks++;
+	if (dashboard_render_ticks >= TIMER_TICK_MS_TO_TICKS(DASHBOARD_RENDER_MS_)){
+		DASHBOARD_RenderField(dashboard_field);
+		dashboard_field = (dashboard_field == UPPER_ROW) ? LOWER_ROW : UPPER_ROW;
+		dashboard_render_ticks = 0;
+	}
+}
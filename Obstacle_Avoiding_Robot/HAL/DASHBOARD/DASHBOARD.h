@@ -0,0 +1,184 @@
+/*
+ * DASHBOARD.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef HAL_DASHBOARD_DASHBOARD_H_
+#define HAL_DASHBOARD_DASHBOARD_H_
+
+/* Button */
+/*
+ * NOTE:
+ * 		The button connects INT0 (PD2) to the ground, and the internal pull-up keeps it high otherwise.
+ * 		INT1 is taken by the echo of the ultrasonic sensor, and INT2 (PB2) by RW of the LCD.
+ *
+ */
+#define DASHBOARD_BUTTON_PORT			INT0_PORT
+#define DASHBOARD_BUTTON_PIN			INT0
+#define DASHBOARD_DEBOUNCE_MS_			200			// Edges closer than this to the last press are taken as bouncing.
+
+/* Timing */
+#define DASHBOARD_WINDOW_MS_			1000		// Rates and the tick load are measured over this time.
+#define DASHBOARD_PAGE_MS_				3000		// Time that each page is shown while cycling automatically.
+#define DASHBOARD_RENDER_MS_			50			// One field is printed into the LCD buffer every this time.
+
+/* Battery */
+/*
+ * NOTE:
+ * 		The battery is read on PA2 (ADC2) through a divider of 30k (from the battery) over 10k (to the ground), which divides
+ * 		it by 4 (CAR_CURRENT_BATTERY_DIVIDER), so up to 10.24V can be read with the internal 2.56V reference.
+ * 		Set DASHBOARD_BATTERY to 0 on boards without this divider, then "--.--" is shown instead of a floating input.
+ *
+ */
+#define DASHBOARD_BATTERY				1
+
+/* Stack */
+/*
+ * NOTE:
+ * 		The free SRAM between the variables and the stack is filled with a pattern by DASHBOARD_PaintStack(), and the free
+ * 		stack is the part that still holds the pattern, so it is the least free stack since start-up (not the current one).
+ * 		It is counted upward from the variables to the first byte that lost the pattern, once per DASHBOARD_WINDOW_MS_, by
+ * 		DASHBOARD_MeasureStack() from the main loop, since scanning up to 2KB is too long for the tick.
+ *
+ */
+#define DASHBOARD_STACK_PATTERN			0xC5
+
+/* Pages */
+typedef enum{
+	DASHBOARD_PAGE_LOOP,			// Loop rate and tick ISR load.
+	DASHBOARD_PAGE_ULTRASONIC,		// Ping rate and timeouts.
+	DASHBOARD_PAGE_MOTORS,			// Duty cycle of each motor.
+	DASHBOARD_PAGE_POWER,			// Battery voltage (if DASHBOARD_BATTERY) and free stack.
+	DASHBOARD_PAGE_LATENCY,			// Worst reflex latency and worst lateness of the motor PWM interrupts.
+	DASHBOARD_PAGES
+} DASHBOARD_pages;
+
+/* Cycling */
+typedef enum{
+	DASHBOARD_BUTTON_ONLY,
+	DASHBOARD_AUTO_CYCLE
+} DASHBOARD_cycle_mode;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void DASHBOARD_PaintStack(void);
+void DASHBOARD_Init(DASHBOARD_cycle_mode mode);
+void DASHBOARD_CountLoop(void);
+void DASHBOARD_MeasureStack(void);
+void DASHBOARD_NextPage(void);
+u16_t DASHBOARD_GetFreeStack(void);
+void DASHBOARD_DrawLabels(void);
+void DASHBOARD_RenderField(u8_t row);
+u8_t DASHBOARD_GetWorstPwmLateness(void);
+void DASHBOARD_Measure(void);
+void DASHBOARD_Button_InterruptHandler(void);
+void DASHBOARD_Update(void);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	DASHBOARD_PaintStack(void):
+ * 				@brief	Fill the free SRAM under the stack with DASHBOARD_STACK_PATTERN.
+ *
+ * 				@details
+ * 						- It must be the first call in main(), so the stack has not gone deeper yet.
+ * 						- Without it, the free stack is shown as 0.
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_Init(DASHBOARD_cycle_mode mode):
+ * 				@brief	Take the whole LCD and start showing the diagnostics pages from the system tick.
+ *
+ * 				@details
+ * 						- LCD_Init() must be called first. The LCD background refresh is started if it was not.
+ * 						- The application must not print anything into the LCD afterwards, since the tick owns the buffer.
+ * 						- The button on INT0 shows the next page in both modes. With DASHBOARD_AUTO_CYCLE, the page also
+ * 						  changes every DASHBOARD_PAGE_MS_.
+ *
+ * 				@param mode: DASHBOARD_BUTTON_ONLY or DASHBOARD_AUTO_CYCLE.
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_CountLoop(void):
+ * 				@brief	Count one pass of the main loop, for the loop rate.
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_MeasureStack(void):
+ * 				@brief	Count the free stack when the tick asks for it (once per DASHBOARD_WINDOW_MS_).
+ *
+ * 				@details
+ * 						- It must be called from the main loop, not from an interrupt, since the scan may take hundreds of microseconds.
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_NextPage(void):
+ * 				@brief	Show the next page (from the tick).
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_GetFreeStack(void):
+ * 				@brief	Get the least free stack since DASHBOARD_PaintStack().
+ *
+ * 				@details
+ * 						- It returns the last count of DASHBOARD_MeasureStack(), so it is short enough for the tick.
+ *
+ * 				@return u16_t free stack in bytes.
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_DrawLabels(void):
+ * 				@brief	Print the labels and units of the current page into the LCD buffer (both whole rows).
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_RenderField(u8_t row):
+ * 				@brief	Print the value of one row of the current page into the LCD buffer.
+ *
+ * 				@details
+ * 						- Only the cells of the value are written, and the background refresh sends only the ones that changed.
+ *
+ * 				@param row: UPPER_ROW or LOWER_ROW.
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_GetWorstPwmLateness(void):
+ * 				@brief	Get the worst lateness of the four motor PWM interrupts (TIMER_Profile_GetWorstLatency()).
+ *
+ * 				@details
+ * 						- It stays 0 unless TIMER_PROFILE_LATENCY is 1.
+ *
+ * 				@return u8_t timer counts.
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_Measure(void):
+ * 				@brief	Calculate the rates and the tick load over the last window.
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_Button_InterruptHandler(void):
+ * 				@brief	Request the next page when the button is pressed (INT0 callback).
+ *
+ *	____________________________________________________________________________________
+
+ *	DASHBOARD_Update(void):
+ * 				@brief	Measure, change the page and print one field when their time comes (Tick callback).
+ *
+ * 				@details
+ * 						- At most one field is printed per tick, and the LCD bus is written only by the background refresh
+ * 						  (LCD_REFRESH_NIBBLES_PER_TICK per tick), so the dashboard costs the same whatever the page shows.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* HAL_DASHBOARD_DASHBOARD_H_ */
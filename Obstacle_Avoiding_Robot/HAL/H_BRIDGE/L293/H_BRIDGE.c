@@ -8,22 +8,45 @@
 #include "../../../LIB/STD_TYPES.h"
 #include "../../../LIB/BIT_MATH.h"
 #include "../../../MCAL/DIO/DIO.h"
+#include "../../../MCAL/INTERRUPT/INTERRUPT.h"
 #include "../../../MCAL/TIMER/TIMER.h"
+#include "../../../MCAL/TIMER/TICK/TICK.h"
 #include "../../../HAL/LCD/LCD.h"
 #include "H_BRIDGE.h"
 
+/* Pins of each motor for each state (free stop, fast stop, CW, CCW) */
+const u8_t H_bridge_motor1_A_pins[4] = {0, 0, (1 << H_A2), (1 << H_A1)};
+const u8_t H_bridge_motor2_A_pins[4] = {0, 0, (1 << H_A4), (1 << H_A3)};
+const u8_t H_bridge_motor1_EN_pins[4] = {0, (1 << H_EN1), (1 << H_EN1), (1 << H_EN1)};
+const u8_t H_bridge_motor2_EN_pins[4] = {0, (1 << H_EN2), (1 << H_EN2), (1 << H_EN2)};
+
+/* Dead Time */
+u8_t H_bridge_dead_ticks = TIMER_TICK_MS_TO_TICKS(H_BRIDGE_DEAD_TIME_MS_);
+volatile u8_t H_bridge_idle_ticks[2] = {255, 255};			// Ticks since each motor was last driven (stays at 255).
+volatile u8_t H_bridge_last_direction[2] = {H_BRIDGE_FREE_STOP, H_BRIDGE_FREE_STOP};	// CW or CCW that each motor was last driven in.
+
 void H_BRIDGE_L293_Motor_Init(u8_t EN, u8_t x, u8_t y){
 	DIO_SetPinDirection(H_bridge_EN_PORT, EN, PIN_OUTPUT);
-	DIO_SetPinDirection(H_bridge_A_PORT, x, PIN_OUTPUT);
-	DIO_SetPinDirection(H_bridge_A_PORT, y, PIN_OUTPUT);
+	DIO_SetPinsDirectionMasked(H_bridge_A_PORT, (1 << x) | (1 << y), PORT_OUTPUT);
+	TIMER_TICK_Init();
+	TIMER_TICK_AddCallBack(H_BRIDGE_L293_Update);				// Registered only once, even though it is called for each motor.
 }
+
 void H_BRIDGE_L293_Motor_CW(u8_t EN, u8_t x, u8_t y){
+	if (!H_BRIDGE_L293_DeadTime_Allow(H_BRIDGE_MOTOR_INDEX(EN), H_BRIDGE_CW)){
+		H_BRIDGE_L293_Motor_FastStop(EN, x, y);				// Keep braking until the dead time passes.
+		return;
+	}
 	DIO_SetPinValue(H_bridge_EN_PORT, EN, PIN_HIGH);
 	DIO_SetPinValue(H_bridge_A_PORT, x, PIN_LOW);
 	DIO_SetPinValue(H_bridge_A_PORT, y, PIN_HIGH);
 }
 
 void H_BRIDGE_L293_Motor_CCW(u8_t EN, u8_t x, u8_t y){
+	if (!H_BRIDGE_L293_DeadTime_Allow(H_BRIDGE_MOTOR_INDEX(EN), H_BRIDGE_CCW)){
+		H_BRIDGE_L293_Motor_FastStop(EN, x, y);
+		return;
+	}
 	DIO_SetPinValue(H_bridge_EN_PORT, EN, PIN_HIGH);
 	DIO_SetPinValue(H_bridge_A_PORT, x, PIN_HIGH);
 	DIO_SetPinValue(H_bridge_A_PORT, y, PIN_LOW);
@@ -39,3 +62,53 @@ void H_BRIDGE_L293_Motor_FastStop(u8_t EN, u8_t x, u8_t y){
 void H_BRIDGE_L293_Motor_FreeStop(u8_t EN){
 	DIO_SetPinValue(H_bridge_EN_PORT, EN, PIN_LOW);
 }
+
+void H_BRIDGE_L293_SetBoth(H_BRIDGE_motor_state state1, H_BRIDGE_motor_state state2){
+	u8_t A_pins;
+	u8_t EN_pins;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	if (!H_BRIDGE_L293_DeadTime_Allow(0, state1)){
+		state1 = H_BRIDGE_FAST_STOP;
+	}
+	if (!H_BRIDGE_L293_DeadTime_Allow(1, state2)){
+		state2 = H_BRIDGE_FAST_STOP;
+	}
+	A_pins = H_bridge_motor1_A_pins[state1] | H_bridge_motor2_A_pins[state2];
+	EN_pins = H_bridge_motor1_EN_pins[state1] | H_bridge_motor2_EN_pins[state2];
+	H_bridge_A_PORT_REGISTER = (H_bridge_A_PORT_REGISTER & ~H_BRIDGE_A_MASK) | A_pins;
+	H_bridge_EN_PORT_REGISTER = (H_bridge_EN_PORT_REGISTER & ~H_BRIDGE_EN_MASK) | EN_pins;
+	SREG = sreg;
+}
+
+u8_t H_BRIDGE_L293_DeadTime_Allow(u8_t motor, H_BRIDGE_motor_state state){
+	if (state != H_BRIDGE_CW && state != H_BRIDGE_CCW){
+		return 1;											// Stopping is always allowed.
+	}
+	if (state != H_bridge_last_direction[motor] && H_bridge_idle_ticks[motor] < H_bridge_dead_ticks){
+		return 0;											// Reversed while the motor may still spin the other way.
+	}
+	H_bridge_last_direction[motor] = state;
+	H_bridge_idle_ticks[motor] = 0;
+	return 1;
+}
+
+void H_BRIDGE_L293_SetDeadTime_ms_(u16_t time){
+	u32_t ticks = TIMER_TICK_MS_TO_TICKS(time);
+	H_bridge_dead_ticks = (ticks > 254) ? 254 : ticks;		// The idle counter stops at 255, so the dead time can always pass.
+}
+
+void H_BRIDGE_L293_SkipDeadTime(void){
+	// As if both motors were idle for the longest time, so the next direction is allowed whatever the last one was.
+	H_bridge_idle_ticks[0] = 255;
+	H_bridge_idle_ticks[1] = 255;
+}
+
+void H_BRIDGE_L293_Update(void){
+	u8_t motor;
+	for (motor = 0; motor < 2; motor++){
+		if (H_bridge_idle_ticks[motor] != 255){
+			H_bridge_idle_ticks[motor]++;
+		}
+	}
+}
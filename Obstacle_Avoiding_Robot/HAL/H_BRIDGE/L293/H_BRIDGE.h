@@ -20,11 +20,41 @@
 #define H_A3						PIN_5
 #define H_A4						PIN_6
 
+/* Registers of the ports above, for writing both motors at once */
+#define H_bridge_EN_PORT_REGISTER	PORTD
+#define H_bridge_A_PORT_REGISTER	PORTC
+
+#define H_BRIDGE_EN_MASK			((1 << H_EN1) | (1 << H_EN2))
+#define H_BRIDGE_A_MASK				((1 << H_A1) | (1 << H_A2) | (1 << H_A3) | (1 << H_A4))
+
+/* Dead Time */
+/*
+ * NOTE:
+ * 		Reversing a motor while it still spins drives it against its back EMF, and the current spike can brown out the LCD.
+ * 		So a motor that is driven in the opposite direction of its last one is kept in fast stop (brake) until it has not been
+ * 		driven for the dead time. The PWM interrupts keep asking for the new direction, so it starts by itself after that.
+ *
+ */
+#define H_BRIDGE_DEAD_TIME_MS_		50
+#define H_BRIDGE_MOTOR_INDEX(EN)	(((EN) == H_EN1) ? 0 : 1)
+
+typedef enum{
+	H_BRIDGE_FREE_STOP,
+	H_BRIDGE_FAST_STOP,
+	H_BRIDGE_CW,
+	H_BRIDGE_CCW
+} H_BRIDGE_motor_state;
+
 void H_BRIDGE_L293_Motor_Init(u8_t EN, u8_t x, u8_t y);
 void H_BRIDGE_L293_Motor_CW(u8_t EN, u8_t x, u8_t y);
 void H_BRIDGE_L293_Motor_CCW(u8_t EN, u8_t x, u8_t y);
 void H_BRIDGE_L293_Motor_FastStop(u8_t EN, u8_t x, u8_t y);
 void H_BRIDGE_L293_Motor_FreeStop(u8_t EN);
+void H_BRIDGE_L293_SetBoth(H_BRIDGE_motor_state state1, H_BRIDGE_motor_state state2);
+u8_t H_BRIDGE_L293_DeadTime_Allow(u8_t motor, H_BRIDGE_motor_state state);
+void H_BRIDGE_L293_SetDeadTime_ms_(u16_t time);
+void H_BRIDGE_L293_SkipDeadTime(void);
+void H_BRIDGE_L293_Update(void);
 
 /*
  * .-----------------------------.
@@ -49,6 +79,7 @@ void H_BRIDGE_L293_Motor_FreeStop(u8_t EN);
  * 				@details
  * 						- Activates the enable pin.
  * 						- Sets one control pin low and the other high to rotate the motor clockwise.
+ * 						- Brakes instead if the motor was last driven counterclockwise within the dead time.
  *
  * 				@param EN: The enable pin.
  * 				@param x: First control pin (IN1 or IN3).
@@ -62,6 +93,7 @@ void H_BRIDGE_L293_Motor_FreeStop(u8_t EN);
  * 				@details
  * 						- Activates the enable pin.
  * 						- Sets one control pin high and the other low to rotate the motor counterclockwise.
+ * 						- Brakes instead if the motor was last driven clockwise within the dead time.
  *
  * 				@param EN: The enable pin.
  * 				@param x: First control pin (IN1 or IN3).
@@ -92,6 +124,49 @@ void H_BRIDGE_L293_Motor_FreeStop(u8_t EN);
  *
  *	____________________________________________________________________________________
 
+ *	H_BRIDGE_L293_SetBoth(H_BRIDGE_motor_state state1, H_BRIDGE_motor_state state2):
+ * 				@brief	Set the state of both motors at the same instant.
+ *
+ * 				@details
+ * 						- The pins of both motors are calculated first, then written with one masked write to the A port
+ * 						  and one to the EN port, so both wheels change together.
+ * 						- The other pins of both ports are not changed.
+ * 						- Interrupts are disabled during the writes, so an ISR cannot change the ports in between.
+ * 						- A motor that is reversed within the dead time is set to fast stop instead.
+ *
+ * 				@param state1: State of motor 1 (EN1, A1, A2).
+ * 				@param state2: State of motor 2 (EN2, A3, A4).
+ *
+ *	____________________________________________________________________________________
+
+ *	H_BRIDGE_L293_DeadTime_Allow(u8_t motor, H_BRIDGE_motor_state state):
+ * 				@brief	Check if a motor may be set to a state now, and remember its direction if it is driven.
+ *
+ * 				@param motor: 0 for motor 1 (EN1), 1 for motor 2 (EN2).
+ * 				@param state: State that the motor is going to be set to.
+ *
+ * 				@return 1 if allowed, 0 if it is a reversal within the dead time.
+ *
+ *	____________________________________________________________________________________
+
+ *	H_BRIDGE_L293_SetDeadTime_ms_(u16_t time):
+ * 				@brief	Set the time that a motor is braked before it is reversed (0 disables it, up to about 260ms).
+ *
+ *	____________________________________________________________________________________
+
+ *	H_BRIDGE_L293_SkipDeadTime(void):
+ * 				@brief	Let the next direction of both motors start at once (e.g. for a reverse braking pulse).
+ *
+ * 				@details
+ * 						- The idle time of both motors is set as passed, so the dead time applies again only after they are driven.
+ *
+ *	____________________________________________________________________________________
+
+ *	H_BRIDGE_L293_Update(void):
+ * 				@brief	Count the ticks since each motor was last driven (Tick callback).
+ *
+ *	____________________________________________________________________________________
+
  */
 
 
@@ -7,12 +7,42 @@
 
 #include "../../LIB/STD_TYPES.h"
 #include "../../LIB/BIT_MATH.h"
+#include "../../LIB/FLASH.h"
 #include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/INTERRUPT/INTERRUPT.h"
+#include "../../MCAL/TIMER/TICK/TICK.h"
 #include <avr/delay.h>
 #include "LCD.h"
 
 /* Variables */
 u8_t mode_of_operation;
+u8_t lcd_busy_flag_usable = 0;			// Set after the interface is configured, and cleared if the busy flag never clears.
+u8_t lcd_buffer[LCD_ROWS][LCD_COLUMNS];		// Characters that the application wrote.
+u8_t lcd_displayed[LCD_ROWS][LCD_COLUMNS];	// Characters that are on the LCD now.
+u8_t lcd_cursor_row = UPPER_ROW;
+u8_t lcd_cursor_col = 0;
+u8_t lcd_background_running = 0;
+volatile u8_t lcd_bus_locked = 0;			// Set while the main context uses the LCD pins, so the tick does not start a new byte.
+volatile u8_t lcd_refresh_pending = 0;		// Set when the upper nibble of lcd_refresh_byte is sent and the lower one is not yet.
+u8_t lcd_refresh_byte;
+u8_t lcd_refresh_rs;
+u8_t lcd_refresh_cell = 0;					// Cell (0 to 31) that the search for a changed cell starts from.
+u8_t lcd_refresh_address = 0xFF;			// Address counter of the LCD, 0xFF when it is unknown.
+
+/* Powers of ten of each digit of a u16_t */
+const u16_t lcd_powers_of_ten[LCD_U16_DIGITS] = {10000, 1000, 100, 10, 1};
+
+/* Custom characters (one byte per row, 5 dots in the lower bits) */
+const u8_t lcd_glyphs[LCD_GLYPHS][LCD_GLYPH_ROWS] FLASH_SECTION = {
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},		// Not used.
+	{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10},		// LCD_GLYPH_BAR_1
+	{0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18},		// LCD_GLYPH_BAR_2
+	{0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C},		// LCD_GLYPH_BAR_3
+	{0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E},		// LCD_GLYPH_BAR_4
+	{0x04, 0x0E, 0x15, 0x04, 0x04, 0x04, 0x04, 0x00},		// LCD_GLYPH_ARROW_UP
+	{0x04, 0x04, 0x04, 0x04, 0x15, 0x0E, 0x04, 0x00},		// LCD_GLYPH_ARROW_DOWN
+	{0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00}		// LCD_GLYPH_STOP
+};
 
 
 /********************************\
@@ -20,50 +50,65 @@ u8_t mode_of_operation;
 \********************************/
 
 void LCD_Init(LCD_modes_of_operation mode){
+	u8_t row;
+	u8_t col;
 	mode_of_operation = mode;						// Mode is saved in a variable.
 	DIO_SetPinDirection(Control_Port, E, PIN_OUTPUT);
 	DIO_SetPinDirection(Control_Port, RS, PIN_OUTPUT);
 	DIO_SetPinDirection(Control_Port, RW, PIN_OUTPUT);
 	switch (mode){
 	case _4bits:									// When dealing with 4 bits, only 4 pins are output.
-		DIO_SetPinDirection(Data_Port, D4, PIN_OUTPUT);
-		DIO_SetPinDirection(Data_Port, D5, PIN_OUTPUT);
-		DIO_SetPinDirection(Data_Port, D6, PIN_OUTPUT);
-		DIO_SetPinDirection(Data_Port, D7, PIN_OUTPUT);
+		DIO_SetPinsDirectionMasked(Data_Port, LCD_DATA_MASK, PORT_OUTPUT);
 		break;
 
 	case _8bits:
 		DIO_SetPortDirection(Data_Port, PORT_OUTPUT);// When dealing with 8 bits, the whole port is output.
 		break;
 	}
-	_delay_ms(50);
-	LCD_ReturnHome();
-	LCD_EntryModeSet(INCREMENT,SHIFT_OFF);							// Increment the addresses 1 when writing into or reading from them. No display shifting.
+	/*
+	 * NOTE:
+	 * 		The power-on time is counted from TIMER_TICK_Init(), so if the tick is started first in main(), the other modules
+	 * 		are initialized during it instead of waiting here.
+	 * 		Then the interface is reset by instruction as in the HD44780 datasheet, since the internal reset is not reliable,
+	 * 		and each wait is only the minimum of the datasheet, timed by the tick (_delay_us() is not exact at -O0).
+	 *
+	 */
+	TIMER_TICK_Init();
+	while (TIMER_TICK_GetTicks() < TIMER_TICK_MS_TO_TICKS(LCD_POWER_ON_MS_) + 1);
+	lcd_busy_flag_usable = 0;				// The busy flag cannot be read before the LCD is in the same mode (4 or 8 bits).
+	LCD_WriteInitInstruction(LCD_RESET_INSTRUCTION);
+	LCD_Wait_us_(LCD_RESET_FIRST_WAIT_US_);
+	LCD_WriteInitInstruction(LCD_RESET_INSTRUCTION);
+	LCD_Wait_us_(LCD_RESET_WAIT_US_);
+	LCD_WriteInitInstruction(LCD_RESET_INSTRUCTION);
+	LCD_Wait_us_(LCD_RESET_WAIT_US_);
+	if (mode == _4bits){
+		LCD_WriteInitInstruction(LCD_4_BITS_INSTRUCTION);	// Still read as 8 bits, so only the upper nibble is sent.
+		LCD_Wait_us_(LCD_RESET_WAIT_US_);
+	}
+	lcd_busy_flag_usable = 1;				// From here, each instruction waits only as long as the LCD is busy.
+	LCD_FunctionSet(mode, _2_LINES, _5x8_DOTS);					// Mode is taken as an argument. 2 lines mode. 5*8 dots.
 	LCD_DisplayControl(DISPLAY_ON, CURSOR_OFF, CURSOR_BLINK_OFF);	// Display is on. No cursor. No cursor blinking (when needed).
-	LCD_FunctionSet(mode, _2_LINES, _5x8_DOTS);					// Mode is taken as an argument. 2 lines mode. 5*10 dots.
+	LCD_SendInstruction(1<<D0);					// Clear the LCD itself, then both buffers are filled with spaces like it.
+	LCD_EntryModeSet(INCREMENT,SHIFT_OFF);							// Increment the addresses 1 when writing into or reading from them. No display shifting.
+	LCD_LoadGlyphs();
 	LCD_Clear();
+	for (row = 0; row < LCD_ROWS; row++){
+		for (col = 0; col < LCD_COLUMNS; col++){
+			lcd_displayed[row][col] = ' ';
+		}
+	}
 }
 
 void LCD_SendInstruction(u8_t instruction){
-	DIO_SetPinValue(Control_Port, RS, PIN_LOW);
-	DIO_SetPinValue(Control_Port, RW, PIN_LOW);
+	LCD_LockBus();
+	LCD_WaitWhileBusy();
+	DIO_FAST_SetPinLow(Control_Port, RS);
+	DIO_FAST_SetPinLow(Control_Port, RW);
 	switch (mode_of_operation){
 	case _4bits:
-		/* Sending the upper nibble */
-		DIO_SetPinValue(Data_Port, D7, GET_BIT(instruction, 7));
-		DIO_SetPinValue(Data_Port, D6, GET_BIT(instruction, 6));
-		DIO_SetPinValue(Data_Port, D5, GET_BIT(instruction, 5));
-		DIO_SetPinValue(Data_Port, D4, GET_BIT(instruction, 4));
-		LCD_EnablePulse();
-		LCD_DisablePulse();
-		_delay_ms(100);
-		/* Sending the lower nibble */
-		DIO_SetPinValue(Data_Port, D7, GET_BIT(instruction, 3));
-		DIO_SetPinValue(Data_Port, D6, GET_BIT(instruction, 2));
-		DIO_SetPinValue(Data_Port, D5, GET_BIT(instruction, 1));
-		DIO_SetPinValue(Data_Port, D4, GET_BIT(instruction, 0));
-		LCD_EnablePulse();
-		LCD_DisablePulse();
+		LCD_WriteNibble(instruction);						// Upper nibble.
+		LCD_WriteNibble(instruction << 4);					// Lower nibble.
 		break;
 
 	case _8bits:
@@ -73,29 +118,26 @@ void LCD_SendInstruction(u8_t instruction){
 		LCD_DisablePulse();
 		break;
 	}
-	_delay_us(50);
-
+	LCD_UnlockBus();
 }
 
 void LCD_SendChar(unsigned char character){
-	DIO_SetPinValue(Control_Port, RS, PIN_HIGH);
-	DIO_SetPinValue(Control_Port, RW, PIN_LOW);
+	// Characters after the last column are dropped, since they would not be shown.
+	if (lcd_cursor_col < LCD_COLUMNS){
+		lcd_buffer[lcd_cursor_row][lcd_cursor_col] = character;
+		lcd_cursor_col++;
+	}
+}
+
+void LCD_WriteData(u8_t character){
+	LCD_LockBus();
+	LCD_WaitWhileBusy();
+	DIO_FAST_SetPinHigh(Control_Port, RS);
+	DIO_FAST_SetPinLow(Control_Port, RW);
 	switch (mode_of_operation){
 	case _4bits:
-		/* Sending the upper nibble */
-		DIO_SetPinValue(Data_Port, D7, GET_BIT(character, 7));
-		DIO_SetPinValue(Data_Port, D6, GET_BIT(character, 6));
-		DIO_SetPinValue(Data_Port, D5, GET_BIT(character, 5));
-		DIO_SetPinValue(Data_Port, D4, GET_BIT(character, 4));
-		LCD_EnablePulse();
-		LCD_DisablePulse();
-		/* Sending the lower nibble */
-		DIO_SetPinValue(Data_Port, D7, GET_BIT(character, 3));
-		DIO_SetPinValue(Data_Port, D6, GET_BIT(character, 2));
-		DIO_SetPinValue(Data_Port, D5, GET_BIT(character, 1));
-		DIO_SetPinValue(Data_Port, D4, GET_BIT(character, 0));
-		LCD_EnablePulse();
-		LCD_DisablePulse();
+		LCD_WriteNibble(character);						// Upper nibble.
+		LCD_WriteNibble(character << 4);					// Lower nibble.
 		break;
 	case _8bits:
 		LCD_EnablePulse();
@@ -103,17 +145,27 @@ void LCD_SendChar(unsigned char character){
 		LCD_DisablePulse();
 		break;
 	}
+	LCD_UnlockBus();
 }
 
 void LCD_SendString(char* c){
-	for (u8_t i = 0; c[i]; i++){	// Iterates until c[i] is false meaning that it is a null operator '\0'
+	u8_t i;
+	for (i = 0; c[i]; i++){	// Iterates until c[i] is false meaning that it is a null operator '\0'
 		LCD_SendChar(c[i]);
 	}
 }
 
+void LCD_SendString_P(const char* c){
+	u8_t character;
+	while ((character = FLASH_ReadByte(c++))){		// Read from the program memory until the null character '\0'.
+		LCD_SendChar(character);
+	}
+}
+
 void LCD_SendNumber(double num){
 	u32_t truncated = (u32_t) num;
 	u8_t counter = 0;
+	u8_t i;
 	if (truncated == num){
 		u32_t copy_truncated = truncated;
 		u8_t int_list [10];
@@ -125,7 +177,7 @@ void LCD_SendNumber(double num){
 			copy_truncated /= 10;
 			counter ++;
 		}
-		for (u8_t i = counter; i > 0; i--){
+		for (i = counter; i > 0; i--){
 			LCD_SendChar(int_list[i-1]);
 		}
 	}
@@ -146,79 +198,311 @@ void LCD_SendNumber(double num){
 		while (fractional_list [counter - 1] == '0'){
 			counter--;
 		}
-		for (u8_t i = 0; i < counter; i++){
+		for (i = 0; i < counter; i++){
 			LCD_SendChar(fractional_list[i]);
 		}
 	}
 }
 
-void LCD_GoToPosition(LCD_rows row, u8_t col){
-	switch (row){
-	// Upper row positions ranges from 0x00 (col = 0) to 0x0f (col = 15)
-	case UPPER_ROW:
-		LCD_SetDDRAMAddress(col);
-		break;
-	// Upper row positions ranges from 0x40 (col = 0) to 0x4f (col = 15)
-	case LOWER_ROW:
-		LCD_SetDDRAMAddress(0x40 + col);
-		break;
+void LCD_SendU16(u16_t num){
+	LCD_SendU16Padded(num, 0);
+}
+
+void LCD_SendU16Padded(u16_t num, u8_t width){
+	u8_t digits[LCD_U16_DIGITS];
+	u8_t first;
+	u8_t i;
+	// Each digit is found by subtracting its power of ten (9 times at most), since the AVR has no divide instruction.
+	for (i = 0; i < LCD_U16_DIGITS; i++){
+		digits[i] = '0';
+		while (num >= lcd_powers_of_ten[i]){
+			num -= lcd_powers_of_ten[i];
+			digits[i]++;
+		}
+	}
+	for (first = 0; first < LCD_U16_DIGITS - 1 && digits[first] == '0'; first++);		// Skip the leading zeros, but keep the last digit.
+	for (i = LCD_U16_DIGITS - first; i < width; i++){
+		LCD_SendChar(' ');
+	}
+	for (i = first; i < LCD_U16_DIGITS; i++){
+		LCD_SendChar(digits[i]);
 	}
 }
 
+void LCD_GoToPosition(LCD_rows row, u8_t col){
+	lcd_cursor_row = (row == LOWER_ROW) ? LOWER_ROW : UPPER_ROW;
+	lcd_cursor_col = col;
+}
+
 void LCD_Clear(void){
-	LCD_SendInstruction(1<<D0);
+	u8_t row;
+	u8_t col;
+	for (row = 0; row < LCD_ROWS; row++){
+		for (col = 0; col < LCD_COLUMNS; col++){
+			lcd_buffer[row][col] = ' ';
+		}
+	}
+	lcd_cursor_row = UPPER_ROW;
+	lcd_cursor_col = 0;
+}
+
+void LCD_Flush(void){
+	u8_t address = 0xFF;						// Address counter of the LCD, unknown before the first write.
+	u8_t row;
+	u8_t col;
+	if (lcd_background_running){
+		return;									// The tick sends the changed cells by itself.
+	}
+	for (row = 0; row < LCD_ROWS; row++){
+		for (col = 0; col < LCD_COLUMNS; col++){
+			if (lcd_buffer[row][col] == lcd_displayed[row][col]){
+				continue;
+			}
+			// The address counter increases after each write, so a run of changed cells needs only one address.
+			if (address != LCD_CELL_ADDRESS(row, col)){
+				LCD_SetDDRAMAddress(LCD_CELL_ADDRESS(row, col));
+			}
+			LCD_WriteData(lcd_buffer[row][col]);
+			lcd_displayed[row][col] = lcd_buffer[row][col];
+			address = LCD_CELL_ADDRESS(row, col) + 1;
+		}
+	}
 }
 
 void LCD_ReturnHome(void){
 	LCD_SendInstruction(1<<D1);
-	// The maximum execution time is 1520us for 270KHz f(OSC), So it is converted to match our 16MHz f(OSC).
-	_delay_us(1520*(float)(270/16000));
 }
 
 void LCD_EntryModeSet(u8_t cursor_move, u8_t display_shift){
 	LCD_SendInstruction((1 << D2) | ((1 & cursor_move) << D1) | ((1 & display_shift) << D0));
-	// The maximum execution time is in nanoseconds for our 16MHz f(OSC), so it could be approximated to be 1us.
-	_delay_us(1);
 }
 
 void LCD_DisplayControl(u8_t display_mode, u8_t cursor_display, u8_t cursor_blink){
 	LCD_SendInstruction((1 << D3) | ((1 & display_mode) << D2) | ((1 & cursor_display) << D1) | ((1 & cursor_blink) << D0));
-	// The maximum execution time is in nanoseconds for our 16MHz f(OSC), so it could be approximated to be 1us.
-	_delay_us(1);
 }
 
 void LCD_CursorOrDisplayShift(u8_t cursor_or_display, u8_t right_or_left){
 	LCD_SendInstruction((1 << D4) | ((1 & cursor_or_display) << D3) | ((1 & right_or_left) << D2));
-	// The maximum execution time is in nanoseconds for our 16MHz f(OSC), so it could be approximated to be 1us.
-	_delay_us(1);
 }
 
 void LCD_FunctionSet(u8_t data_length, u8_t display_lines_num, u8_t char_font){
 	LCD_SendInstruction((1 << D5) | ((1 & data_length) << D4) | ((1 & display_lines_num) << D3) | ((1 & char_font) << D2));
-	// The maximum execution time is in nanoseconds for our 16MHz f(OSC), so it could be approximated to be 1us.
-	_delay_us(1);
 }
 
 void LCD_SetCGRAMAddress(u8_t address){
 	address &= 0b00111111; // Address is ANDed with 0b111111 to ensure it is in the range(0:31)
 	LCD_SendInstruction((1 << D6) | address);
-	// The maximum execution time is in nanoseconds for our 16MHz f(OSC), so it could be approximated to be 1us.
-	_delay_us(1);
 }
 
 void LCD_SetDDRAMAddress(u8_t address){
 	address &= 0b01111111; // Address is ANDed with 0b111111 to ensure it is in the range(0:63)
 	LCD_SendInstruction((1 << D7) | address);
-	// The maximum execution time is in nanoseconds for our 16MHz f(OSC), so it could be approximated to be 1us.
-	_delay_us(1);
+}
+
+void LCD_LoadGlyphs(void){
+	u8_t glyph;
+	u8_t row;
+	LCD_SetCGRAMAddress(0);
+	// The CGRAM address increases after each row like the DDRAM one, so all the slots are written one after the other.
+	for (glyph = 0; glyph < LCD_GLYPHS; glyph++){
+		for (row = 0; row < LCD_GLYPH_ROWS; row++){
+			LCD_WriteData(FLASH_ReadByte(&lcd_glyphs[glyph][row]));
+		}
+	}
+	LCD_SetDDRAMAddress(0);						// Characters are written into the DDRAM again.
+}
+
+void LCD_SendBar(u8_t cells, u16_t value, u16_t maximum){
+	u8_t columns;
+	u8_t i;
+	if (value > maximum){
+		value = maximum;
+	}
+	columns = (maximum == 0) ? 0 : (u8_t) ((u32_t) value * cells * LCD_BAR_COLUMNS_PER_CELL / maximum);
+	for (i = 0; i < cells; i++){
+		if (columns >= LCD_BAR_COLUMNS_PER_CELL){
+			LCD_SendChar(LCD_FULL_BLOCK);
+			columns -= LCD_BAR_COLUMNS_PER_CELL;
+		}
+		else if (columns){
+			LCD_SendChar(LCD_GLYPH_BAR_1 - 1 + columns);
+			columns = 0;
+		}
+		else{
+			LCD_SendChar(' ');
+		}
+	}
+}
+
+void LCD_WriteNibble(u8_t nibble){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	// One masked write puts the whole nibble on D4 to D7, and the other pins of the port (ADC inputs) are not changed.
+	LCD_DATA_PORT_REGISTER = (LCD_DATA_PORT_REGISTER & ~LCD_DATA_MASK) | (nibble & LCD_DATA_MASK);
+	SREG = sreg;
+	LCD_EnablePulse();
+	LCD_DisablePulse();
+}
+
+void LCD_WriteInitInstruction(u8_t instruction){
+	DIO_FAST_SetPinLow(Control_Port, RS);
+	DIO_FAST_SetPinLow(Control_Port, RW);
+	if (mode_of_operation == _4bits){
+		LCD_WriteNibble(instruction);
+	}
+	else{
+		DIO_SetPortValue(Data_Port, instruction);
+		LCD_EnablePulse();
+		LCD_DisablePulse();
+	}
+}
+
+void LCD_Wait_us_(u16_t time){
+	u32_t start = TIMER_TICK_GetCounts();
+	u32_t counts = (u32_t) time * (F_CPU / 1000000UL) / TIMER_TICK_CYCLES_PER_COUNT + 1;	// Rounded up, since the start is within a count.
+	while (TIMER_TICK_GetCounts() - start < counts);
 }
 
 void LCD_EnablePulse(void){
-	DIO_SetPinValue(Control_Port, E, PIN_HIGH);
-	_delay_ms(1);
+	DIO_FAST_SetPinHigh(Control_Port, E);
+	LCD_E_DELAY();							// E pulse width is at least 450ns, and data is valid 360ns after E rises when reading.
 }
 
 void LCD_DisablePulse(void){
-	DIO_SetPinValue(Control_Port, E ,PIN_LOW);
-	_delay_ms(1);
+	DIO_FAST_SetPinLow(Control_Port, E);
+	LCD_E_DELAY();							// E cycle is at least 1000ns, so E stays low at least as long as it was high.
+}
+
+u8_t LCD_WaitWhileBusy(void){
+	u16_t polls = LCD_BUSY_TIMEOUT_POLLS;
+	u8_t busy;
+	if (!lcd_busy_flag_usable){
+		_delay_ms(LCD_SLOWEST_INSTRUCTION_MS_);		// Without the busy flag, the longest instruction (clear or return home) is waited.
+		return 1;
+	}
+	/* Data pins as inputs without pull-ups, then read the busy flag (D7) with RS = 0 and RW = 1 */
+	if (mode_of_operation == _4bits){
+		DIO_SetPinsDirectionMasked(Data_Port, LCD_DATA_MASK, PORT_INPUT);
+		DIO_WritePortMasked(Data_Port, LCD_DATA_MASK, PORT_LOW);
+	}
+	else{
+		DIO_SetPortDirection(Data_Port, PORT_INPUT);
+		DIO_SetPortValue(Data_Port, PORT_LOW);
+	}
+	DIO_FAST_SetPinLow(Control_Port, RS);
+	DIO_FAST_SetPinHigh(Control_Port, RW);
+	do{
+		LCD_EnablePulse();
+		busy = DIO_FAST_GetPinValue(Data_Port, D7);
+		LCD_DisablePulse();
+		if (mode_of_operation == _4bits){
+			// The lower nibble (address counter) must be clocked out too, so the next read starts from the upper nibble.
+			LCD_EnablePulse();
+			LCD_DisablePulse();
+		}
+		polls--;
+	} while (busy && polls);
+	DIO_FAST_SetPinLow(Control_Port, RW);
+	if (mode_of_operation == _4bits){
+		DIO_SetPinsDirectionMasked(Data_Port, LCD_DATA_MASK, PORT_OUTPUT);
+	}
+	else{
+		DIO_SetPortDirection(Data_Port, PORT_OUTPUT);
+	}
+	if (busy){
+		lcd_busy_flag_usable = 0;			// RW is probably not wired, so fixed delays are used from now on.
+		return 0;
+	}
+	return 1;
+}
+
+/* Background Refresh */
+void LCD_StartBackgroundRefresh(void){
+	lcd_refresh_address = 0xFF;
+	TIMER_TICK_Init();
+	TIMER_TICK_AddCallBack(LCD_Refresh_Update);
+	lcd_background_running = 1;
+}
+
+void LCD_LockBus(void){
+	lcd_bus_locked = 1;
+	while (lcd_refresh_pending);				// A byte that the tick started is finished first (within one tick).
+}
+
+void LCD_UnlockBus(void){
+	if (lcd_background_running){
+		LCD_WaitWhileBusy();					// The tick writes without checking the busy flag, so a long instruction must end here.
+	}
+	lcd_refresh_address = 0xFF;					// The address counter may have been changed (or pointed to the CGRAM).
+	lcd_bus_locked = 0;
+}
+
+void LCD_Refresh_Update(void){
+	u8_t cell;
+	u8_t row;
+	u8_t col;
+	u8_t i;
+	if (!lcd_background_running){
+		return;
+	}
+	if (lcd_refresh_pending){
+		LCD_WriteNibble(lcd_refresh_byte << 4);
+		lcd_refresh_pending = 0;
+		return;
+	}
+	if (lcd_bus_locked){
+		return;
+	}
+	// Search for the next changed cell, starting after the last one that was sent, so every cell gets its turn.
+	for (i = 0; i < LCD_ROWS * LCD_COLUMNS; i++){
+		cell = lcd_refresh_cell;
+		row = cell / LCD_COLUMNS;
+		col = cell % LCD_COLUMNS;
+		if (lcd_buffer[row][col] != lcd_displayed[row][col]){
+			break;
+		}
+		lcd_refresh_cell = (cell + 1) % (LCD_ROWS * LCD_COLUMNS);
+	}
+	if (i == LCD_ROWS * LCD_COLUMNS){
+		return;									// Nothing changed.
+	}
+	if (lcd_refresh_address != LCD_CELL_ADDRESS(row, col)){
+		lcd_refresh_byte = (1 << D7) | LCD_CELL_ADDRESS(row, col);		// Set DDRAM address instruction.
+		lcd_refresh_rs = 0;
+		lcd_refresh_address = LCD_CELL_ADDRESS(row, col);
+	}
+	else{
+		lcd_refresh_byte = lcd_buffer[row][col];
+		lcd_refresh_rs = 1;
+		lcd_displayed[row][col] = lcd_refresh_byte;
+		lcd_refresh_address++;
+		lcd_refresh_cell = (cell + 1) % (LCD_ROWS * LCD_COLUMNS);
+	}
+	/*
+	 * NOTE:
+	 * 		One tick (1.024ms) is longer than every instruction (37us) except clear display and return home (1.52ms), which need two ticks,
+	 * 		so the busy flag does not need to be read between the bytes sent from here.
+	 *
+	 */
+	if (lcd_refresh_rs){
+		DIO_FAST_SetPinHigh(Control_Port, RS);
+	}
+	else{
+		DIO_FAST_SetPinLow(Control_Port, RS);
+	}
+	DIO_FAST_SetPinLow(Control_Port, RW);
+	if (mode_of_operation == _4bits){
+		LCD_WriteNibble(lcd_refresh_byte);
+		if (LCD_REFRESH_NIBBLES_PER_TICK > 1){
+			LCD_WriteNibble(lcd_refresh_byte << 4);
+		}
+		else{
+			lcd_refresh_pending = 1;			// The lower nibble is sent on the next tick.
+		}
+	}
+	else{
+		DIO_SetPortValue(Data_Port, lcd_refresh_byte);
+		LCD_EnablePulse();
+		LCD_DisablePulse();
+	}
 }
@@ -36,12 +36,99 @@ typedef enum{
 #define D6				PIN_6
 #define D7				PIN_7
 
+/*
+ * NOTE:
+ * 		In 4-bit mode, D4 to D7 must stay on pins 4 to 7 of Data_Port, so each nibble is written with one masked write.
+ *
+ */
+#define LCD_DATA_MASK	((1 << D4) | (1 << D5) | (1 << D6) | (1 << D7))
+#define LCD_DATA_PORT_REGISTER	PORTA		// Register of Data_Port, for writing a whole nibble at once.
+
+/* Enable Pulse */
+/*
+ * NOTE:
+ * 		_delay_us() is not exact without optimization (the project is built with -O0), so the E pulse is timed by cycles.
+ * 		8 cycles at 16MHz are 500ns, just above the minimum pulse width of the HD44780 (450ns).
+ *
+ */
+#define LCD_E_DELAY()	__asm__ __volatile__ ("nop" "\n\t" "nop" "\n\t" "nop" "\n\t" "nop" "\n\t" "nop" "\n\t" "nop" "\n\t" "nop" "\n\t" "nop")
+
+/* Initialization */
+/*
+ * NOTE:
+ * 		The times are the minimum ones of the HD44780 datasheet.
+ *
+ */
+#define LCD_POWER_ON_MS_			40			// From the supply reaching 2.7V to the first instruction.
+#define LCD_RESET_FIRST_WAIT_US_	4100		// After the first function set of the reset.
+#define LCD_RESET_WAIT_US_			100			// After the other ones (longer than the 37us of any instruction).
+#define LCD_RESET_INSTRUCTION		0x30		// Function set to 8 bits, sent 3 times to reset the interface.
+#define LCD_4_BITS_INSTRUCTION		0x20		// Function set to 4 bits, sent as an 8-bit instruction.
+
+/* Busy Flag */
+/*
+ * NOTE:
+ * 		Before each instruction or character, the busy flag is read until the LCD finishes the last one (37us for most
+ * 		of them, 1.52ms for clear and return home), instead of waiting a fixed time after each of them.
+ * 		Each poll takes about 4us in 4-bit mode, so the timeout is about 10ms.
+ *
+ */
+#define LCD_BUSY_TIMEOUT_POLLS		2500
+#define LCD_SLOWEST_INSTRUCTION_MS_	2			// Waited instead while the busy flag cannot be read (during LCD_Init()).
+
 /* Rows */
 typedef enum{
 	UPPER_ROW,
 	LOWER_ROW
 } LCD_rows;
 
+/* Buffer */
+/*
+ * NOTE:
+ * 		LCD_SendChar(), LCD_SendString(), LCD_SendNumber(), LCD_GoToPosition() and LCD_Clear() only change a copy of the
+ * 		screen in RAM. LCD_Flush() sends the cells that differ from what is on the LCD, so an unchanged screen costs nothing.
+ *
+ */
+#define LCD_ROWS					2
+#define LCD_COLUMNS					16
+#define LCD_CELL_ADDRESS(row, col)	(((row) == LOWER_ROW) ? 0x40 + (col) : (col))
+
+/* Background Refresh */
+/*
+ * NOTE:
+ * 		The LCD needs 37us after a whole byte before it takes the next one, so the tick sends at most one byte (2 nibbles)
+ * 		without waiting. With 1, each byte is split over 2 ticks and the tick ISR stays as short as possible.
+ *
+ */
+#define LCD_REFRESH_NIBBLES_PER_TICK	1		// Bus writes per tick in 4-bit mode (1 or 2).
+
+/* Numbers */
+#define LCD_U16_DIGITS				5		// 65535
+
+/* Custom Characters */
+/*
+ * NOTE:
+ * 		The glyphs are loaded into the CGRAM by LCD_Init(), and printed with LCD_SendChar() like any other character.
+ * 		Slot 0 is not used, since a character code of 0 would end a string.
+ * 		The right and left arrows and the full block are already in the character ROM of the HD44780 (A00).
+ *
+ */
+#define LCD_GLYPHS					8		// Slots in the CGRAM (5x8 dots).
+#define LCD_GLYPH_ROWS				8
+#define LCD_GLYPH_BAR_1				1		// 1 to 4 columns of the cell filled from the left.
+#define LCD_GLYPH_BAR_2				2
+#define LCD_GLYPH_BAR_3				3
+#define LCD_GLYPH_BAR_4				4
+#define LCD_GLYPH_ARROW_UP			5
+#define LCD_GLYPH_ARROW_DOWN		6
+#define LCD_GLYPH_STOP				7
+#define LCD_ARROW_RIGHT				0x7E
+#define LCD_ARROW_LEFT				0x7F
+#define LCD_FULL_BLOCK				0xFF
+
+/* Bar Graph */
+#define LCD_BAR_COLUMNS_PER_CELL	5		// Each cell is 5 dots wide, so a bar has 5 steps per cell.
+
 /* Entry Mode Parameters */
 #define DECREMENT		0
 #define INCREMENT		1
@@ -80,10 +167,15 @@ typedef enum{
 void LCD_Init(LCD_modes_of_operation mode);
 void LCD_SendInstruction(u8_t instruction);
 void LCD_SendChar(unsigned char character);
+void LCD_WriteData(u8_t character);
 void LCD_SendString(char* c);
+void LCD_SendString_P(const char* c);
 void LCD_SendNumber(double num);
-void LCD_GoToPosition(u8_t row, u8_t col);
+void LCD_SendU16(u16_t num);
+void LCD_SendU16Padded(u16_t num, u8_t width);
+void LCD_GoToPosition(LCD_rows row, u8_t col);
 void LCD_Clear(void);
+void LCD_Flush(void);
 void LCD_ReturnHome(void);
 void LCD_EntryModeSet(u8_t cursor_move, u8_t display_shift);
 void LCD_DisplayControl(u8_t display_mode, u8_t cursor_display, u8_t cursor_blink);
@@ -91,8 +183,18 @@ void LCD_CursorOrDisplayShift(u8_t cursor_or_display, u8_t right_or_left);
 void LCD_FunctionSet(u8_t data_length, u8_t display_lines_num, u8_t char_font);
 void LCD_SetCGRAMAddress(u8_t address);
 void LCD_SetDDRAMAddress(u8_t address);
+void LCD_LoadGlyphs(void);
+void LCD_SendBar(u8_t cells, u16_t value, u16_t maximum);
+void LCD_WriteNibble(u8_t nibble);
+void LCD_WriteInitInstruction(u8_t instruction);
+void LCD_Wait_us_(u16_t time);
 void LCD_EnablePulse(void);
 void LCD_DisablePulse(void);
+u8_t LCD_WaitWhileBusy(void);
+void LCD_StartBackgroundRefresh(void);
+void LCD_LockBus(void);
+void LCD_UnlockBus(void);
+void LCD_Refresh_Update(void);
 
 /*
  * .-----------------------------.
@@ -106,6 +208,10 @@ void LCD_DisablePulse(void);
  * 						- Set control pins as outputs.
  * 						- If the input mode is 4 bits, only pins (D4-D7) are set as output pins.
  * 						- If the input mode is 8 bits, all the pins are set as output pins.
+ * 						- Starts the system tick, and waits until LCD_POWER_ON_MS_ passed since it was started
+ * 						  (global interrupts must be enabled, since the waits are timed by the tick).
+ * 						- Resets the interface by instruction, then configures the LCD and loads the custom characters,
+ * 						  which takes about 10ms after the power-on time.
  *
  * 				@param mode: The mode of operation which is 4 bits or 8 bits.
  *
@@ -119,12 +225,19 @@ void LCD_DisablePulse(void);
  *	____________________________________________________________________________________
 
  *	LCD_SendChar(unsigned char character);
- *				@brief Print a character into the LCD.
+ *				@brief Print a character into the buffer at the cursor, and move the cursor to the next column.
  *
  *				@param character: The character to be sent.
  *
  *	____________________________________________________________________________________
 
+ *	LCD_WriteData(u8_t character);
+ *				@brief Write a byte into the DDRAM or CGRAM of the LCD at its address counter (without the buffer).
+ *
+ *				@param character: The byte to be written.
+ *
+ *	____________________________________________________________________________________
+
  *	LCD_SendString(char* str);
  *				@brief Print a string into the LCD.
  *
@@ -132,6 +245,16 @@ void LCD_DisablePulse(void);
  *
  *	____________________________________________________________________________________
 
+ *	LCD_SendString_P(const char* str);
+ *				@brief Print a string that is stored in the program memory (with FLASH_SECTION) into the LCD.
+ *
+ *				@details
+ *						- The string is read from the flash one character at a time, so it never takes any SRAM.
+ *
+ *				@param str: Flash address of the null-terminated string to be sent.
+ *
+ *	____________________________________________________________________________________
+
  *	LCD_SendNumber(double num);
  *				@brief Print a number into the LCD.
  *
@@ -139,8 +262,27 @@ void LCD_DisablePulse(void);
  *
  *	____________________________________________________________________________________
 
- *	LCD_GoToPosition(u8_t row, u8_t col);
- *				@brief Go to specific position in LCD.
+ *	LCD_SendU16(u16_t num);
+ *				@brief Print an integer into the LCD, faster than LCD_SendNumber() (no floating point or division).
+ *
+ *				@param num: The number to be sent.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_SendU16Padded(u16_t num, u8_t width);
+ *				@brief Print an integer right-aligned in a fixed number of cells.
+ *
+ *				@details
+ *						- Spaces are written before the number, so a shorter number also erases the digits of a longer one.
+ *						- A number with more digits than the width is printed completely.
+ *
+ *				@param num: The number to be sent.
+ *				@param width: Number of cells (0 to 5).
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_GoToPosition(LCD_rows row, u8_t col);
+ *				@brief Move the cursor of the buffer to a specific position.
  *
  *				@param row: The row to be in (UPPER_ROW, LOWER_ROW).
  *				@param col: The column to be in (0, 1, 2, ..., 14, or 15).
@@ -148,7 +290,17 @@ void LCD_DisablePulse(void);
  *	____________________________________________________________________________________
 
  *	LCD_Clear(void);
- *				@brief Clear the LCD display.
+ *				@brief Fill the buffer with spaces and move its cursor to the first position.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_Flush(void);
+ *				@brief Send the changed cells of the buffer to the LCD.
+ *
+ *				@details
+ *						- The cells are compared with what was sent before, and only the different ones are written.
+ *						- A run of changed cells in a row is sent after one LCD_SetDDRAMAddress(), since the LCD moves its
+ *						  address by itself after each character.
  *
  *	____________________________________________________________________________________
 
@@ -215,6 +367,53 @@ void LCD_DisablePulse(void);
  *
  *	____________________________________________________________________________________
 
+ *	LCD_LoadGlyphs(void);
+ *				@brief Write the custom characters (bar steps, arrows and stop) from the flash into the CGRAM.
+ *
+ *				@details
+ *						- It is called by LCD_Init(), and leaves the address counter in the DDRAM.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_SendBar(u8_t cells, u16_t value, u16_t maximum);
+ *				@brief Print a horizontal bar graph into the buffer at the cursor.
+ *
+ *				@details
+ *						- The bar is filled from the left in steps of one dot column (5 steps per cell), using the full block
+ *						  for the filled cells, one LCD_GLYPH_BAR_x for the partial cell, and spaces for the rest.
+ *						- Only the cells that changed are sent by LCD_Flush() (or the background refresh), so a bar that moves
+ *						  by a few steps costs one or two characters.
+ *
+ *				@param cells: Length of the bar in cells (1 to 16).
+ *				@param value: Value shown by the bar (values above maximum fill it completely).
+ *				@param maximum: Value of a full bar.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_WriteNibble(u8_t nibble);
+ *				@brief Put the upper 4 bits of a byte on D4 to D7 with one write, then pulse E.
+ *
+ *				@param nibble: The byte whose upper 4 bits are sent.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_WriteInitInstruction(u8_t instruction);
+ *				@brief Send an instruction as one write of the upper nibble (or the whole byte in 8-bit mode) without the busy flag.
+ *
+ *				@details
+ *						- It is used only to reset the interface, while the LCD may still be in 8-bit mode.
+ *
+ *				@param instruction: The instruction to be sent.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_Wait_us_(u16_t time);
+ *				@brief Wait a number of microseconds using the system tick.
+ *
+ *				@param time: Time to wait in us (4us resolution).
+ *
+ *	____________________________________________________________________________________
+
  *	LCD_EnablePulse(void);
  *				@brief Enable the pulse for data transfer to the LCD.
  *
@@ -225,6 +424,43 @@ void LCD_DisablePulse(void);
  *
  *	____________________________________________________________________________________
 
+ *	LCD_WaitWhileBusy(void);
+ *				@brief Wait until the LCD can take the next instruction or character.
+ *
+ *				@details
+ *						- The busy flag is polled through RW (PB2) and D7, and the data pins are set back as outputs after that.
+ *						- If the busy flag stays set until LCD_BUSY_TIMEOUT_POLLS, the LCD is assumed to be unable to be read,
+ *						  so a fixed delay of LCD_SLOWEST_INSTRUCTION_MS_ is used before each instruction from then on.
+ *
+ *				@return u8_t 1 if the LCD is ready, 0 on a timeout.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_StartBackgroundRefresh(void);
+ *				@brief Send the changed cells of the buffer from the system tick, so LCD_Flush() is not needed anymore.
+ *
+ *				@details
+ *						- Each tick sends LCD_REFRESH_NIBBLES_PER_TICK nibbles (a whole byte in 8-bit mode), which takes a few
+ *						  microseconds, so the load on the bus and on the tick never depends on how much of the screen changed.
+ *						- With one nibble per tick, a changed character costs 2 ticks, plus 2 ticks for the address if it does not
+ *						  follow the last one, so the whole screen is rewritten in about 70ms and a few digits in a few milliseconds.
+ *						- LCD_Init() must be called first.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_LockBus(void), LCD_UnlockBus(void);
+ *				@brief Keep the tick away from the LCD pins while an instruction or a byte is sent from the main context.
+ *
+ *				@details
+ *						- They are called by LCD_SendInstruction() and LCD_WriteData(), so the raw functions can still be used.
+ *
+ *	____________________________________________________________________________________
+
+ *	LCD_Refresh_Update(void);
+ *				@brief Send the next nibbles of the changed cells (Tick callback).
+ *
+ *	____________________________________________________________________________________
+
  */
 
 #endif /* HAL_LCD_LCD_H_ */
@@ -10,10 +10,14 @@
 #include"../../MCAL/DIO/DIO.h"
 #include"../../MCAL/TIMER/TIMER.h"
 #include"../../MCAL/INTERRUPT/INTERRUPT.h"
+#include"../../MCAL/TIMER/TICK/TICK.h"
 #include "../LCD/LCD.h"
 #include"SERVO.h"
 #include<util/delay.h>
 
+/* Variables */
+volatile u16_t servo_remaining_ticks = 0;      // Ticks left until the servo started by SERVO_StartCenter() is settled.
+
 
 /********************************\
 *********** Functions ************
@@ -43,6 +47,43 @@ void SERVO_Center(void)
     _delay_ms(SERVO_WAIT_MS_);                                 // Wait before executing the next operation.
 }
 
+/* Start moving the servo to the center position, and return at once */
+void SERVO_StartCenter(void)
+{
+    SERVO_Init();  // Initialize the servo motor.
+    TIMER_Timer1_OCR1A_Set(SERVO_CENTER_PULSE_PRESCALER_256);  // Set the pulse width for the center position.
+    servo_remaining_ticks = TIMER_TICK_MS_TO_TICKS(SERVO_DELAY_MS_ + SERVO_WAIT_MS_);
+    TIMER_TICK_Init();
+    TIMER_TICK_AddCallBack(SERVO_Update);                      // The same delays as SERVO_Center() are counted by the tick.
+}
+
+/* Check if the servo started by SERVO_StartCenter() is still moving */
+u8_t SERVO_IsMoving(void)
+{
+    u16_t ticks;
+    u8_t sreg = SREG;
+    INTERRUPT_DisableGlobalInterrupt();                        // The tick must not change the counter between its two bytes.
+    ticks = servo_remaining_ticks;
+    SREG = sreg;
+    return ticks != 0;
+}
+
+/* Stop the pulses when the servo reaches the position, then wait for it to settle (Tick callback) */
+void SERVO_Update(void)
+{
+    if (servo_remaining_ticks == 0)
+    {
+        return;
+    }
+    servo_remaining_ticks--;
+    if (servo_remaining_ticks == TIMER_TICK_MS_TO_TICKS(SERVO_WAIT_MS_))
+    {
+        TIMER_Timer1_Stop();                                   // Stop Timer1 after the movement.
+        TIMER_Timer1_OCA_DisableInterrupt();                   // Disable output compare match interrupt.
+        TIMER_Timer1_IC_DisableInterrupt();                    // Disable input capture interrupt.
+    }
+}
+
 /* Move the servo to 90 degrees counterclockwise (CCW) */
 void SERVO_90_CCW(void)
 {
@@ -70,11 +111,11 @@ void SERVO_90_CW(void)
 /* Set the servo pin to high (5V) to generate the rising edge of the pulse */
 void SERVO_High(void)
 {
-    DIO_SetPinValue(SERVO_PORT, SERVO_PIN, PIN_HIGH);  // Set the servo pin to high.
+    DIO_FAST_SetPinHigh(SERVO_PORT, SERVO_PIN);        // Set the servo pin to high (called from the Timer1 ISR, so the fast macro is used).
 }
 
 /* Set the servo pin to low (0V) to generate the falling edge of the pulse */
 void SERVO_Low(void)
 {
-    DIO_SetPinValue(SERVO_PORT, SERVO_PIN, PIN_LOW);   // Set the servo pin to low.
+    DIO_FAST_SetPinLow(SERVO_PORT, SERVO_PIN);         // Set the servo pin to low.
 }
@@ -34,6 +34,9 @@
 
 void SERVO_Init(void);
 void SERVO_Center(void);
+void SERVO_StartCenter(void);
+u8_t SERVO_IsMoving(void);
+void SERVO_Update(void);
 void SERVO_90_CW(void);
 void SERVO_90_CCW(void);
 void SERVO_High(void);
@@ -65,6 +68,28 @@ void SERVO_Low(void);
  *
  *	____________________________________________________________________________________
 
+ *	SERVO_StartCenter(void):
+ * 				@brief	Move the servo to the center position like SERVO_Center(), without blocking.
+ *
+ * 				@details
+ * 						- The pulses are stopped from the system tick after SERVO_DELAY_MS_, then SERVO_WAIT_MS_ is waited too.
+ * 						- Timer1 is used until then, so the motors must not be started in different speeds mode
+ * 						  (or another servo function called) while SERVO_IsMoving() returns 1.
+ *
+ *	____________________________________________________________________________________
+
+ *	SERVO_IsMoving(void):
+ * 				@brief	Check if the servo started by SERVO_StartCenter() has not settled yet.
+ *
+ * 				@return 1 while moving, 0 when it settled.
+ *
+ *	____________________________________________________________________________________
+
+ *	SERVO_Update(void):
+ * 				@brief	Count the movement of SERVO_StartCenter() and stop the pulses at its end (Tick callback).
+ *
+ *	____________________________________________________________________________________
+
  *	SERVO_90_CCW(void):
  * 				@brief	Move the servo to 90 degrees counterclockwise.
  *
@@ -10,6 +10,8 @@
 #include "../../LIB/BIT_MATH.h"
 #include "../../MCAL/DIO/DIO.h"
 #include "../../MCAL/TIMER/TIMER.h"
+#include "../../MCAL/TIMER/TICK/TICK.h"
+#include "../../MCAL/INTERRUPT/INTERRUPT.h"
 #include "../../MCAL/INTERRUPT/EXTERNAL/EXTERNAL.h"
 #include "ULTRASONIC.h"
 #include <util/delay.h>
@@ -18,7 +20,17 @@
 u8_t ultrasonic_state = ULTRASONIC_OFF;
 u8_t ultrasonic_edge = ULTRASONIC_RISING_EDGE;
 u16_t ultrasonic_overflow_counter = 0;
+u32_t ultrasonic_echo_start = 0;
 u16_t ultrasonic_maximum_overflow = (u16_t) 2 * (F_CPU * (ULTRASONIC_MAXIMUM_LENGTH_CM_ / ((double) SOUND_VELOCITY_CM_PER_S_ * 64)) / 256);
+volatile u8_t ultrasonic_reflex_armed = 0;
+volatile u8_t ultrasonic_reflex_triggered = 0;
+u32_t ultrasonic_reflex_counts = 0;							// Echo length (TCNT0 counts) of the reflex distance.
+u16_t ultrasonic_reflex_worst_latency = 0;					// TCNT0 counts from the end of the echo to the return of the reflex callback.
+u16_t ultrasonic_echo_count = 0;							// Echoes received since ULTRASONIC_Init() (wraps).
+u16_t ultrasonic_timeout_count = 0;							// Triggers that got no echo before the timeout (wraps).
+
+/* Function Pointers */
+void (*ultrasonic_reflex_function_pointer) (void)=NULL;
 
 
 /********************************\
@@ -32,17 +44,17 @@ void ULTRASONIC_Init(void){
 	INTERRUPT_EXTERNAL_INT1_EnableInterrupt();
 	INTERRUPT_EXTERNAL_INT1_ControlSense(INT0_INT1_ANY_CHANGE);
 	INTERRUPT_EXTERNAL_INT1_SetCallBack(ULTRASONIC_ECHO_InterruptHandler);
-	TIMER_Timer0_OV_SetCallBack(ULTRASONIC_Timer_OverflowHandler);
+	TIMER_TICK_Init();												// Timer0 is shared with the system tick, so it runs all the time.
+	TIMER_TICK_AddCallBack(ULTRASONIC_Timer_OverflowHandler);
 }
 
 void ULTRASONIC_TRIG_Send(void){
 	if (ultrasonic_state == ULTRASONIC_OFF){
-		TIMER_Timer0_OV_EnableInterrupt();
-		DIO_SetPinValue(ULTRASONIC_PORT, TRIG, PIN_HIGH);
+		DIO_FAST_SetPinHigh(ULTRASONIC_PORT, TRIG);
 		_delay_us(15);
-		DIO_SetPinValue(ULTRASONIC_PORT, TRIG, PIN_LOW);
+		DIO_FAST_SetPinLow(ULTRASONIC_PORT, TRIG);
+		ultrasonic_overflow_counter = 0;
 		ultrasonic_state = ULTRASONIC_ON;
-		TIMER_Timer0_Init(TIMER0_NORMAL, TIMER0_PRESCALER_64);
 		_delay_ms(30);
 	}
 }
@@ -50,15 +62,29 @@ void ULTRASONIC_TRIG_Send(void){
 void ULTRASONIC_ECHO_InterruptHandler(void){
 	if (ultrasonic_state == ULTRASONIC_ON){
 		if (ultrasonic_edge == ULTRASONIC_FALLING_EDGE){
-			TIMER_Timer0_OV_DisableInterrupt();
-			ultrasonic_distance = ((ultrasonic_overflow_counter * 256 + TCNT0) * ((double) SOUND_VELOCITY_CM_PER_S_ * 64 / F_CPU))/2;
-			TIMER_Timer0_Stop();
+			u32_t echo_end = TIMER_TICK_GetCounts();
+			u32_t echo_counts = echo_end - ultrasonic_echo_start;
+			// The reflex is checked on the raw counts first, so the motors are cut before the distance is calculated.
+			if (ultrasonic_reflex_armed && echo_counts < ultrasonic_reflex_counts){
+				u16_t latency;
+				ultrasonic_reflex_armed = 0;
+				ultrasonic_reflex_triggered = 1;
+				if (ultrasonic_reflex_function_pointer){
+					ultrasonic_reflex_function_pointer();
+				}
+				latency = (u16_t) (TIMER_TICK_GetCounts() - echo_end);
+				if (latency > ultrasonic_reflex_worst_latency){
+					ultrasonic_reflex_worst_latency = latency;
+				}
+			}
+			ultrasonic_distance = (echo_counts * ((double) SOUND_VELOCITY_CM_PER_S_ * 64 / F_CPU))/2;
+			ultrasonic_echo_count++;
 			ultrasonic_overflow_counter = 0;
 			ultrasonic_edge = ULTRASONIC_RISING_EDGE;
 			ultrasonic_state = ULTRASONIC_OFF;
 		}
 		else{
-			TCNT0 = 0;
+			ultrasonic_echo_start = TIMER_TICK_GetCounts();		// Timer0 is never reset, so the start of the echo is saved as a timestamp.
 			ultrasonic_overflow_counter = 0;
 			ultrasonic_edge = ULTRASONIC_FALLING_EDGE;
 		}
@@ -66,10 +92,13 @@ void ULTRASONIC_ECHO_InterruptHandler(void){
 }
 
 void ULTRASONIC_Timer_OverflowHandler(void){
+	if (ultrasonic_state == ULTRASONIC_OFF){
+		return;
+	}
 	ultrasonic_overflow_counter++;
 	if(ultrasonic_overflow_counter > ultrasonic_maximum_overflow){
 		ultrasonic_distance = ULTRASONIC_MAXIMUM_LENGTH_CM_;
-		TCNT0 = 0;
+		ultrasonic_timeout_count++;
 		ultrasonic_state = ULTRASONIC_OFF;
 		ultrasonic_edge = ULTRASONIC_RISING_EDGE;
 		ultrasonic_overflow_counter = 0;
@@ -79,3 +108,45 @@ void ULTRASONIC_Timer_OverflowHandler(void){
 u16_t ULTRASONIC_GetDistance_cm_(void){
 	return ultrasonic_distance;
 }
+
+void ULTRASONIC_Reflex_Arm(u16_t distance_cm){
+	// Echo length = 2 * distance / sound velocity, in TCNT0 counts of 64 cycles.
+	ultrasonic_reflex_counts = (u32_t) distance_cm * 2 * (F_CPU / TIMER_TICK_CYCLES_PER_COUNT) / SOUND_VELOCITY_CM_PER_S_;
+	ultrasonic_reflex_triggered = 0;
+	ultrasonic_reflex_armed = 1;
+}
+
+void ULTRASONIC_Reflex_Disarm(void){
+	ultrasonic_reflex_armed = 0;
+	ultrasonic_reflex_triggered = 0;
+}
+
+u8_t ULTRASONIC_Reflex_IsTriggered(void){
+	return ultrasonic_reflex_triggered;
+}
+
+void ULTRASONIC_Reflex_SetCallBack(void (*local_function_pointer) (void)){
+	ultrasonic_reflex_function_pointer = local_function_pointer;
+}
+
+u16_t ULTRASONIC_GetEchoCount(void){
+	u16_t count;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	count = ultrasonic_echo_count;
+	SREG = sreg;
+	return count;
+}
+
+u16_t ULTRASONIC_GetTimeoutCount(void){
+	u16_t count;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	count = ultrasonic_timeout_count;
+	SREG = sreg;
+	return count;
+}
+
+u16_t ULTRASONIC_Reflex_GetWorstLatency_us_(void){
+	return (u32_t) ultrasonic_reflex_worst_latency * TIMER_TICK_CYCLES_PER_COUNT / (F_CPU / 1000000UL);
+}
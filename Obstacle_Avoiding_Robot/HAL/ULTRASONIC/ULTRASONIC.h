@@ -45,6 +45,13 @@ void ULTRASONIC_TRIG_DisableAutoSend(void);
 void ULTRASONIC_ECHO_InterruptHandler(void);
 void ULTRASONIC_Timer_OverflowHandler(void);
 u16_t ULTRASONIC_GetDistance_cm_(void);
+u16_t ULTRASONIC_GetEchoCount(void);
+u16_t ULTRASONIC_GetTimeoutCount(void);
+void ULTRASONIC_Reflex_Arm(u16_t distance_cm);
+void ULTRASONIC_Reflex_Disarm(void);
+u8_t ULTRASONIC_Reflex_IsTriggered(void);
+void ULTRASONIC_Reflex_SetCallBack(void (*local_function_pointer) (void));
+u16_t ULTRASONIC_Reflex_GetWorstLatency_us_(void);
 
 /*
  * .-----------------------------.
@@ -58,7 +65,8 @@ u16_t ULTRASONIC_GetDistance_cm_(void);
  *						- Sets the TRIG pin as output and the ECHO pin as input.
  *						- Enables pull-up resistor for the ECHO pin.
  *						- Configures external interrupt for echo detection.
- *						- Registers callback functions for the interrupt and timer overflow handling.
+ *						- Starts the system tick (Timer0) if it is not running yet.
+ *						- Registers callback functions for the interrupt and the tick (timeout handling).
  *
  * ____________________________________________________________________________________
 
@@ -67,7 +75,7 @@ u16_t ULTRASONIC_GetDistance_cm_(void);
  *
  *				@details
  *						- Sends a 15us high pulse on the TRIG pin to initiate the sensor.
- *						- Starts Timer0 and enables timer overflow interrupt to measure the echo duration.
+ *						- Arms the timeout counter which is increased by the system tick.
  *
  * ____________________________________________________________________________________
 
@@ -75,15 +83,16 @@ u16_t ULTRASONIC_GetDistance_cm_(void);
  *				@brief	Handle the external interrupt caused by the echo signal.
  *
  *				@details
- *						- On the rising edge, starts the timer to count the echo pulse duration.
- *						- On the falling edge, calculates the distance based on the timer value and stops the timer.
+ *						- On the rising edge, saves a timestamp from the system tick (TIMER_TICK_GetCounts()).
+ *						- On the falling edge, calculates the distance based on the time elapsed since that timestamp.
  *
  * ____________________________________________________________________________________
 
  * ULTRASONIC_Timer_OverflowHandler(void):
- *				@brief	Handle the timer overflow during echo signal measurement.
+ *				@brief	Handle the system tick during echo signal measurement.
  *
  *				@details
+ *						- Does nothing if no measurement is in progress.
  *						- Increments the overflow counter.
  *						- If the counter exceeds the maximum allowable overflow, sets the distance to the maximum measurable value.
  *
@@ -96,6 +105,62 @@ u16_t ULTRASONIC_GetDistance_cm_(void);
  *
  * ____________________________________________________________________________________
 
+ * ULTRASONIC_GetEchoCount(void), ULTRASONIC_GetTimeoutCount(void):
+ *				@brief	Get how many echoes were received, or how many triggers timed out without one.
+ *
+ *				@details
+ *						- Both counters wrap, so the difference between two readings is the count in between.
+ *
+ *				@return	u16_t
+ *
+ * ____________________________________________________________________________________
+
+ * ULTRASONIC_Reflex_Arm(u16_t distance_cm):
+ *				@brief	Call the reflex callback from the echo interrupt as soon as an echo is closer than a distance.
+ *
+ *				@details
+ *						- The distance is converted into an echo length once, so the interrupt compares only two integers.
+ *						- The reflex fires once, then it is disarmed until it is armed again.
+ *						- Only arm it while the sensor looks where the car moves (e.g. the servo is centered and the car moves forward).
+ *
+ *				@param distance_cm: Distance that cuts the motors (cm).
+ *
+ * ____________________________________________________________________________________
+
+ * ULTRASONIC_Reflex_Disarm(void):
+ *				@brief	Stop checking the echo against the reflex distance and clear the triggered flag.
+ *
+ * ____________________________________________________________________________________
+
+ * ULTRASONIC_Reflex_IsTriggered(void):
+ *				@brief	Check if the reflex fired since it was armed.
+ *
+ *				@return	1 if it fired, 0 otherwise.
+ *
+ * ____________________________________________________________________________________
+
+ * ULTRASONIC_Reflex_SetCallBack(void (*local_function_pointer) (void)):
+ *				@brief	Set the function that cuts the motors when the reflex fires (e.g. one that calls CAR_BRAKE_Stop()).
+ *
+ *				@details
+ *						- It is called from the INT1 interrupt, so it must be short and must not wait.
+ *
+ * ____________________________________________________________________________________
+
+ * ULTRASONIC_Reflex_GetWorstLatency_us_(void):
+ *				@brief	Get the worst time from the end of the echo to the return of the reflex callback.
+ *
+ *				@details
+ *						- It is measured from the timestamp taken at the start of the interrupt, so the delay of the interrupt itself
+ *						  (a few microseconds, unless another interrupt is running) is not included. The resolution is 4us.
+ *						- It ends when the callback returns (the H-bridge pins are written), so the time the motors need to stop
+ *						  turning is not included either. It is 0 until the reflex fires once.
+ *						- It is shown on the latency page of the dashboard (DASHBOARD 1 in main.c).
+ *
+ *				@return	u16_t latency in microseconds.
+ *
+ * ____________________________________________________________________________________
+
  */
 
 
@@ -0,0 +1,43 @@
+/*
+ * FLASH.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef FLASH_H_
+#define FLASH_H_
+
+/*
+ * NOTE:
+ * 		Constant strings and tables are copied from the flash into the SRAM (2KB only) at start-up, unless they are placed
+ * 		in the program memory with FLASH_SECTION. Then they are not in the data address space, so they must be read with
+ * 		FLASH_ReadByte() or FLASH_ReadWord() (the lpm instruction) instead of a normal pointer access.
+ * 		The ATmega32 has 32KB of flash, so a 16-bit address reaches all of it.
+ *
+ */
+
+/* Placement */
+#define FLASH_SECTION	__attribute__ ((__progmem__))
+
+/* Reading */
+#define FLASH_ReadByte(address)		({															\
+											u16_t flash_address = (u16_t) (address);				\
+											u8_t flash_result;									\
+											__asm__ __volatile__ ("lpm %0, Z"					\
+																  : "=r" (flash_result)			\
+																  : "z" (flash_address));		\
+											flash_result;										\
+										})
+
+#define FLASH_ReadWord(address)		({															\
+											u16_t flash_address = (u16_t) (address);				\
+											u16_t flash_result;									\
+											__asm__ __volatile__ ("lpm %A0, Z+" "\n\t"			\
+																  "lpm %B0, Z"					\
+																  : "=&r" (flash_result), "+z" (flash_address));	\
+											flash_result;										\
+										})
+
+
+#endif /* FLASH_H_ */
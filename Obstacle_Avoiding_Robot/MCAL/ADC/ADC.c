@@ -0,0 +1,78 @@
+/*
+ * ADC.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+#include "ADC.h"
+
+/* Function Pointers */
+void (*ADC_function_pointer) (void)=NULL;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void ADC_Init(ADC_reference reference, ADC_prescaler prescaler){
+	ADMUX = (ADMUX & 0x3F) | (reference << REFS0);		// Right adjusted result.
+	ADCSRA = (ADCSRA & 0xF8) | prescaler;
+	SET_BIT(ADCSRA, ADEN);
+}
+
+void ADC_SetChannel(ADC_channel channel){
+	ADMUX = (ADMUX & 0xE0) | channel;
+}
+
+u16_t ADC_Read(ADC_channel channel){
+	ADC_SetChannel(channel);
+	SET_BIT(ADCSRA, ADSC);
+	while (GET_BIT(ADCSRA, ADSC));		// ADSC is cleared by the hardware when the conversion is completed.
+	return ADC_GetResult();
+}
+
+void ADC_StartFreeRunning(ADC_channel channel){
+	ADC_SetChannel(channel);
+	SFIOR &= ~((1 << ADTS0) | (1 << ADTS1) | (1 << ADTS2));		// Trigger source: free running.
+	SET_BIT(ADCSRA, ADATE);
+	SET_BIT(ADCSRA, ADSC);				// Only the first conversion is started by software.
+}
+
+void ADC_Stop(void){
+	CLEAR_BIT(ADCSRA, ADATE);
+}
+
+u16_t ADC_GetResult(void){
+	u8_t low = ADCL;
+	return ((u16_t) ADCH << 8) | low;
+}
+
+void ADC_EnableInterrupt(void){
+	SET_BIT(ADCSRA, ADIE);
+}
+
+void ADC_DisableInterrupt(void){
+	CLEAR_BIT(ADCSRA, ADIE);
+}
+
+void ADC_SetCallBack(void (*local_function_pointer) (void)){
+	ADC_function_pointer = local_function_pointer;
+}
+
+/* ISR functions */
+
+/*
+ *
+ * __vector_16(void) -> ADC Conversion Complete Interrupt.
+ *
+ */
+
+void __vector_16(void) __attribute__ ((signal, used, externally_visible));
+void __vector_16 (void){
+	if (ADC_function_pointer){			// Check if the function pointer is not NULL
+		ADC_function_pointer();			// Execute the function
+	}
+}
@@ -0,0 +1,177 @@
+/*
+ * ADC.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef MCAL_ADC_ADC_H_
+#define MCAL_ADC_ADC_H_
+
+/* Registers Definition */
+#define ADMUX		(*(volatile u8_t*)0x27)
+#define ADCSRA		(*(volatile u8_t*)0x26)
+#define ADCH		(*(volatile u8_t*)0x25)
+#define ADCL		(*(volatile u8_t*)0x24)
+#define SFIOR		(*(volatile u8_t*)0x50)
+
+/* ADMUX */
+#define MUX0		0
+#define MUX1		1
+#define MUX2		2
+#define MUX3		3
+#define MUX4		4
+#define ADLAR		5
+#define REFS0		6
+#define REFS1		7
+
+/* ADCSRA */
+#define ADPS0		0
+#define ADPS1		1
+#define ADPS2		2
+#define ADIE		3
+#define ADIF		4
+#define ADATE		5
+#define ADSC		6
+#define ADEN		7
+
+/* SFIOR */
+#define ADTS0		5
+#define ADTS1		6
+#define ADTS2		7
+
+#define ADC_MAXIMUM_VALUE		1023
+
+/* ADC - Voltage References */
+typedef enum{
+	ADC_AREF,					// External voltage on AREF pin.
+	ADC_AVCC,					// AVCC with a capacitor on AREF pin.
+	ADC_INTERNAL_2_56V = 3		// Internal 2.56V with a capacitor on AREF pin.
+} ADC_reference;
+
+/* ADC - Prescalers */
+/*
+ * NOTE:
+ * 		The ADC clock must be between 50kHz and 200kHz for the full 10-bit resolution, so 128 is used with 16MHz (125kHz).
+ *
+ */
+typedef enum{
+	ADC_PRESCALER_2 = 1,
+	ADC_PRESCALER_4,
+	ADC_PRESCALER_8,
+	ADC_PRESCALER_16,
+	ADC_PRESCALER_32,
+	ADC_PRESCALER_64,
+	ADC_PRESCALER_128
+} ADC_prescaler;
+
+/* ADC - Channels */
+typedef enum{
+	ADC_CHANNEL_0,				// PA0
+	ADC_CHANNEL_1,				// PA1
+	ADC_CHANNEL_2,				// PA2
+	ADC_CHANNEL_3,				// PA3
+	ADC_CHANNEL_4,				// PA4
+	ADC_CHANNEL_5,				// PA5
+	ADC_CHANNEL_6,				// PA6
+	ADC_CHANNEL_7				// PA7
+} ADC_channel;
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void ADC_Init(ADC_reference reference, ADC_prescaler prescaler);
+void ADC_SetChannel(ADC_channel channel);
+u16_t ADC_Read(ADC_channel channel);
+void ADC_StartFreeRunning(ADC_channel channel);
+void ADC_Stop(void);
+u16_t ADC_GetResult(void);
+void ADC_EnableInterrupt(void);
+void ADC_DisableInterrupt(void);
+void ADC_SetCallBack(void (*local_function_pointer) (void));
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	ADC_Init(ADC_reference reference, ADC_prescaler prescaler):
+ * 				@brief	Initialize and enable the ADC.
+ *
+ * 				@param reference: The voltage that gives the maximum value (AREF, AVCC or internal 2.56V).
+ * 				@param prescaler: The value to divide the frequency of oscillator by to get the ADC clock (2 to 128).
+ *
+ *	____________________________________________________________________________________
+
+ *	ADC_SetChannel(ADC_channel channel):
+ * 				@brief	Select the input of the next conversion.
+ *
+ * 				@details
+ * 						- In free running mode, the next conversion has already started when the interrupt is called,
+ * 						  so the new channel is used by the conversion after it.
+ *
+ * 				@param channel: The input pin (ADC0 to ADC7).
+ *
+ *	____________________________________________________________________________________
+
+ *	ADC_Read(ADC_channel channel):
+ * 				@brief	Convert a channel and wait for the result (polling).
+ *
+ * 				@details
+ * 						- Must not be used while free running mode is started.
+ *
+ * 				@param channel: The input pin (ADC0 to ADC7).
+ *
+ * 				@return u16_t (0 to 1023).
+ *
+ *	____________________________________________________________________________________
+
+ *	ADC_StartFreeRunning(ADC_channel channel):
+ * 				@brief	Start converting continuously.
+ *
+ * 				@details
+ * 						- A new conversion starts as soon as the last one is completed (every 13 ADC clocks).
+ * 						- The interrupt must be enabled to get the results without polling.
+ *
+ * 				@param channel: The input pin of the first conversion.
+ *
+ *	____________________________________________________________________________________
+
+ *	ADC_Stop(void):
+ * 				@brief	Stop the free running mode after the current conversion.
+ *
+ *	____________________________________________________________________________________
+
+ *	ADC_GetResult(void):
+ * 				@brief	Get the result of the last conversion.
+ *
+ * 				@details
+ * 						- ADCL is read first, since reading it locks the ADC data registers until ADCH is read.
+ *
+ * 				@return u16_t (0 to 1023).
+ *
+ *	____________________________________________________________________________________
+
+ *	ADC_EnableInterrupt(void):
+ * 				@brief Enable the conversion complete interrupt.
+ *
+ *	____________________________________________________________________________________
+
+ *	ADC_DisableInterrupt(void):
+ * 				@brief Disable the conversion complete interrupt.
+ *
+ *	____________________________________________________________________________________
+
+ *	ADC_SetCallBack(void (*local_function_pointer) (void)):
+ * 				@brief	Set callback function for the conversion complete interrupt.
+ *
+ * 				@param local_function_pointer: Pointer to the function that will be called when a conversion is completed.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* MCAL_ADC_ADC_H_ */
@@ -7,8 +7,12 @@
 
 #include "../../LIB/STD_TYPES.h"
 #include "../../LIB/BIT_MATH.h"
+#include "../INTERRUPT/INTERRUPT.h"
 #include "DIO.h"
 
+/* Variables */
+u8_t dio_audit_main_pins[DIO_PORTS];		// Pins of each port written with interrupts enabled (from the main context).
+u8_t dio_audit_isr_pins[DIO_PORTS];			// Pins of each port written with interrupts disabled (from ISRs).
 
 
 /********************************\
@@ -55,6 +59,11 @@ void DIO_SetPortValue(u8_t port, u8_t value){
 }
 
 void DIO_TogglePort(u8_t port){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	if (DIO_AUDIT){
+		DIO_Audit_Record(port, PORT_HIGH, sreg);
+	}
 	switch (port){
 	case PORT_A:
 		PORTA ^= PORT_HIGH;
@@ -69,6 +78,52 @@ void DIO_TogglePort(u8_t port){
 		PORTD ^= PORT_HIGH;
 		break;
 	}
+	SREG = sreg;
+}
+
+void DIO_WritePortMasked(u8_t port, u8_t mask, u8_t value){
+	u8_t sreg = SREG;
+	value &= mask;
+	INTERRUPT_DisableGlobalInterrupt();		// An ISR writing other pins of the port must not be undone by this read-modify-write.
+	if (DIO_AUDIT){
+		DIO_Audit_Record(port, mask, sreg);
+	}
+	switch (port){
+	case PORT_A:
+		PORTA = (PORTA & ~mask) | value;
+		break;
+	case PORT_B:
+		PORTB = (PORTB & ~mask) | value;
+		break;
+	case PORT_C:
+		PORTC = (PORTC & ~mask) | value;
+		break;
+	case PORT_D:
+		PORTD = (PORTD & ~mask) | value;
+		break;
+	}
+	SREG = sreg;
+}
+
+void DIO_SetPinsDirectionMasked(u8_t port, u8_t mask, u8_t direction){
+	u8_t sreg = SREG;
+	direction &= mask;
+	INTERRUPT_DisableGlobalInterrupt();
+	switch (port){
+	case PORT_A:
+		DDRA = (DDRA & ~mask) | direction;
+		break;
+	case PORT_B:
+		DDRB = (DDRB & ~mask) | direction;
+		break;
+	case PORT_C:
+		DDRC = (DDRC & ~mask) | direction;
+		break;
+	case PORT_D:
+		DDRD = (DDRD & ~mask) | direction;
+		break;
+	}
+	SREG = sreg;
 }
 
 u8_t DIO_GetPortValue(u8_t port){
@@ -97,6 +152,8 @@ u8_t DIO_GetPortValue(u8_t port){
 
 /* Dealing with pins */
 void DIO_SetPinDirection(u8_t port, u8_t pin, u8_t direction){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();		// An ISR landing between the read and the write would have its change undone.
 	switch (direction){
 	case PIN_INPUT:
 		switch (port){
@@ -130,9 +187,15 @@ void DIO_SetPinDirection(u8_t port, u8_t pin, u8_t direction){
 				break;
 			}
 	}
+	SREG = sreg;
 }
 
 void DIO_SetPinValue(u8_t port, u8_t pin, u8_t value){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();		// An ISR landing between the read and the write would have its change undone.
+	if (DIO_AUDIT){
+		DIO_Audit_Record(port, 1 << pin, sreg);
+	}
 	switch (value){
 	case PIN_LOW:
 		switch (port){
@@ -182,6 +245,7 @@ void DIO_SetPinValue(u8_t port, u8_t pin, u8_t value){
 			break;
 		}
 	}
+	SREG = sreg;
 }
 
 u8_t DIO_GetPinValue(u8_t port, u8_t pin){
@@ -204,6 +268,11 @@ u8_t DIO_GetPinValue(u8_t port, u8_t pin){
 }
 
 void DIO_EnablePinPullup(u8_t port, u8_t pin){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();		// An ISR landing between the read and the write would have its change undone.
+	if (DIO_AUDIT){
+		DIO_Audit_Record(port, 1 << pin, sreg);
+	}
 	switch (port){
 	case PORT_A:
 		SET_BIT(PORTA, pin);
@@ -218,7 +287,46 @@ void DIO_EnablePinPullup(u8_t port, u8_t pin){
 		SET_BIT(PORTD, pin);
 		break;
 	}
+	SREG = sreg;
 }
 
 
+  /******************************************************************/
+ /***************************** Audit ******************************/
+/******************************************************************/
+
+void DIO_Audit_Record(u8_t port, u8_t pins, u8_t sreg){
+	if (port > PORT_D){
+		return;
+	}
+	if (GET_BIT(sreg, I)){
+		dio_audit_main_pins[port] |= pins;
+	}
+	else{
+		dio_audit_isr_pins[port] |= pins;
+	}
+}
+
+u8_t DIO_Audit_GetSharedPins(u8_t port){
+	u8_t shared;
+	u8_t sreg;
+	if (port > PORT_D){
+		return 0;
+	}
+	sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	shared = dio_audit_main_pins[port] & dio_audit_isr_pins[port];
+	SREG = sreg;
+	return shared;
+}
 
+void DIO_Audit_Reset(void){
+	u8_t port;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	for (port = PORT_A; port < DIO_PORTS; port++){
+		dio_audit_main_pins[port] = 0;
+		dio_audit_isr_pins[port] = 0;
+	}
+	SREG = sreg;
+}
@@ -36,6 +36,7 @@
 #define PORT_B   1
 #define PORT_C   2
 #define PORT_D   3
+#define DIO_PORTS	4
 
 /* Port - Direction */
 #define PORT_INPUT 		0x00		// 0x00 = 0b00000000
@@ -54,6 +55,8 @@
 void DIO_SetPortDirection(u8_t port, u8_t direction);
 void DIO_SetPortValue(u8_t port, u8_t value);
 void DIO_TogglePort(u8_t port);
+void DIO_WritePortMasked(u8_t port, u8_t mask, u8_t value);
+void DIO_SetPinsDirectionMasked(u8_t port, u8_t mask, u8_t direction);
 u8_t DIO_GetPortValue(u8_t port);
 
 
@@ -84,6 +87,28 @@ u8_t DIO_GetPortValue(u8_t port);
  *
  *	____________________________________________________________________________________
  *
+ *	DIO_WritePortMasked(u8_t port, u8_t mask, u8_t value):
+ * 				@brief	Set the value of several pins of a port at the same instant.
+ *
+ * 				@details
+ * 						- Only the pins that are set in the mask are changed, and all of them change with one write.
+ * 						- Interrupts are disabled during the read-modify-write, so an ISR changing other pins of the port is not undone.
+ *
+ * 				@param port		: The port containing the pins (PORT_A, PORT_B, PORT_C, or PORT_D)
+ * 				@param mask		: The pins to be set (e.g. (1 << PIN_4) | (1 << PIN_5)).
+ * 				@param value	: The values of the pins in their bit positions (the other bits are ignored).
+ *
+ *	____________________________________________________________________________________
+ *
+ *	DIO_SetPinsDirectionMasked(u8_t port, u8_t mask, u8_t direction):
+ * 				@brief	Set the direction of several pins of a port at the same instant, like DIO_WritePortMasked().
+ *
+ * 				@param port		: The port containing the pins (PORT_A, PORT_B, PORT_C, or PORT_D)
+ * 				@param mask		: The pins whose direction is to be set.
+ * 				@param direction: The directions of the pins in their bit positions (e.g. PORT_OUTPUT for all of them).
+ *
+ *	____________________________________________________________________________________
+ *
  *	DIO_GetPortValue(u8_t port):
  * 				@brief	Get (Read) the value of a whole port.
  *
@@ -147,6 +172,9 @@ void DIO_EnablePinPullup(u8_t port, u8_t pin);
  *	DIO_SetPinValue(u8_t port, u8_t pin, u8_t value):
  * 				@brief	Set the value of a pin.
  *
+ * 				@details
+ * 						- Interrupts are disabled during the read-modify-write, so it is safe on ports that ISRs change too.
+ *
  * 				@param port		: The port containing the pin (PORT_A, PORT_B, PORT_C, or PORT_D).
  * 				@param pin		: The pin whose value is to be set (PIN_0, PIN_1,..., PIN_6, or PIN_7).
  * 				@param value	: The value of the pin (PIN_LOW, PIN_HIGH, or PIN_TOGGLE).
@@ -181,4 +209,118 @@ void DIO_EnablePinPullup(u8_t port, u8_t pin);
  */
 
 
+  /******************************************************************/
+ /*************************** Fast Pins ****************************/
+/******************************************************************/
+
+/*
+ * NOTE:
+ * 		The functions above choose the register with a switch on every call, which takes tens of cycles at -O0.
+ * 		When the port and the pin are constants (e.g. #define names), these macros compile into one "sbi", "cbi" or "sbic"
+ * 		instruction instead (2 cycles). They do not work with variables, so the functions are still used for them.
+ * 		Since it is one instruction, an interrupt cannot land in the middle of the read-modify-write.
+ * 		The I/O addresses are the memory addresses minus 0x20, and each port is 3 addresses below the one before it:
+ * 		PORTA 0x1B, DDRA 0x1A, PINA 0x19, PORTB 0x18, ..., PIND 0x10.
+ *
+ */
+#define DIO_PORT_IO_ADDRESS(port)		(0x1B - 3 * (port))
+#define DIO_DDR_IO_ADDRESS(port)		(0x1A - 3 * (port))
+#define DIO_PIN_IO_ADDRESS(port)		(0x19 - 3 * (port))
+
+#define DIO_FAST_SetPinHigh(port, pin)		__asm__ __volatile__ ("sbi %0, %1" :: "I" (DIO_PORT_IO_ADDRESS(port)), "I" (pin))
+#define DIO_FAST_SetPinLow(port, pin)		__asm__ __volatile__ ("cbi %0, %1" :: "I" (DIO_PORT_IO_ADDRESS(port)), "I" (pin))
+#define DIO_FAST_SetPinOutput(port, pin)	__asm__ __volatile__ ("sbi %0, %1" :: "I" (DIO_DDR_IO_ADDRESS(port)), "I" (pin))
+#define DIO_FAST_SetPinInput(port, pin)		__asm__ __volatile__ ("cbi %0, %1" :: "I" (DIO_DDR_IO_ADDRESS(port)), "I" (pin))
+#define DIO_FAST_GetPinValue(port, pin)		({ u8_t fast_value;																\
+											__asm__ __volatile__ ("ldi %0, 0" "\n\t" "sbic %1, %2" "\n\t" "ldi %0, 1"		\
+													: "=d" (fast_value) : "I" (DIO_PIN_IO_ADDRESS(port)), "I" (pin));			\
+											fast_value; })
+
+/*
+ * .-----------------------------.
+ * |Explanation of each macro    |
+ * '-----------------------------'
+ *	DIO_FAST_SetPinHigh(port, pin), DIO_FAST_SetPinLow(port, pin):
+ * 				@brief	Set the value of a pin with one instruction (2 cycles).
+ *
+ * 				@param port		: Constant port (PORT_A, PORT_B, PORT_C, or PORT_D).
+ * 				@param pin		: Constant pin (PIN_0, PIN_1,..., PIN_6, or PIN_7).
+ *
+ *	____________________________________________________________________________________
+ *
+ *	DIO_FAST_SetPinOutput(port, pin), DIO_FAST_SetPinInput(port, pin):
+ * 				@brief	Set the direction of a pin with one instruction (2 cycles).
+ *
+ *	____________________________________________________________________________________
+ *
+ *	DIO_FAST_GetPinValue(port, pin):
+ * 				@brief	Get (Read) the value of a pin (4 cycles at most).
+ *
+ *				@return u8_t 0 or 1.
+ *
+ *	____________________________________________________________________________________
+ *
+ */
+
+
+
+  /******************************************************************/
+ /***************************** Audit ******************************/
+/******************************************************************/
+
+/*
+ * NOTE:
+ * 		All the DIO functions change the registers with interrupts disabled, and the fast macros use one instruction,
+ * 		so a pin changed by an ISR is never undone by a read-modify-write in the main context (e.g. PORTD, where TRIG is set
+ * 		from main while the H-bridge enables and the servo pin are set from the timer ISRs).
+ * 		Sharing a port between both contexts is therefore fine, but sharing a pin is not, since its level then depends on
+ * 		which one wrote it last. Set DIO_AUDIT to 1 to record the owner of each output pin written through the DIO functions,
+ * 		and DIO_Audit_GetSharedPins() gives the pins that were written from both.
+ * 		Only the DIO functions are seen. Direct register accesses (e.g. in TIMER, LCD and SERVO) and the fast macros are not.
+ *
+ */
+#define DIO_AUDIT		0
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void DIO_Audit_Record(u8_t port, u8_t pins, u8_t sreg);
+u8_t DIO_Audit_GetSharedPins(u8_t port);
+void DIO_Audit_Reset(void);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+ *	DIO_Audit_Record(u8_t port, u8_t pins, u8_t sreg):
+ * 				@brief	Record the context that output pins are written from (called by the DIO functions when DIO_AUDIT is 1).
+ *
+ * 				@details
+ * 						- The context is taken from the I flag of SREG before the function disabled the interrupts,
+ * 						  so a change inside an atomic section of the main context is counted as an ISR one.
+ *
+ * 				@param port		: The port being changed (PORT_A, PORT_B, PORT_C, or PORT_D).
+ * 				@param pins		: Mask of the pins being written.
+ * 				@param sreg		: SREG at the start of the function.
+ *
+ *	____________________________________________________________________________________
+ *
+ *	DIO_Audit_GetSharedPins(u8_t port):
+ * 				@brief	Get the pins of a port that were written both from the main context and from ISRs since the last reset.
+ *
+ * 				@param port		: The port (PORT_A, PORT_B, PORT_C, or PORT_D).
+ *
+ *				@return u8_t (1 << pin) | ..., or 0 (also for an invalid port).
+ *
+ *	____________________________________________________________________________________
+ *
+ *	DIO_Audit_Reset(void):
+ * 				@brief	Clear the recorded ports.
+ *
+ *	____________________________________________________________________________________
+ *
+ */
+
 #endif /* MCAL_DIO_DIO_H_ */
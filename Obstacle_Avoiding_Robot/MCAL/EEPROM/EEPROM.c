@@ -0,0 +1,61 @@
+/*
+ * EEPROM.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+#include "../INTERRUPT/INTERRUPT.h"
+#include "EEPROM.h"
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+u8_t EEPROM_ReadByte(u16_t address){
+	while (GET_BIT(EECR, EEWE));		// Wait until the previous write is completed.
+	EEARH = (u8_t) (address >> 8);
+	EEARL = (u8_t) address;
+	SET_BIT(EECR, EERE);				// The CPU is halted for 4 cycles then the data is ready in EEDR.
+	return EEDR;
+}
+
+void EEPROM_WriteByte(u16_t address, u8_t data){
+	u8_t sreg;
+	if (EEPROM_ReadByte(address) == data){
+		return;
+	}
+	EEARH = (u8_t) (address >> 8);
+	EEARL = (u8_t) address;
+	EEDR = data;
+	sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	/*
+	 * NOTE:
+	 * 		According to the datasheet, EEWE must be set within 4 cycles after EEMWE, otherwise the write is ignored.
+	 * 		SET_BIT() is compiled into several instructions with -O0, so "sbi" is written directly here.
+	 * 		0x1C is the I/O address of EECR (0x3C - 0x20).
+	 *
+	 */
+	__asm__ __volatile__ ("sbi 0x1C, 2" "\n\t" "sbi 0x1C, 1" ::: "memory");
+	SREG = sreg;
+}
+
+void EEPROM_ReadBlock(u16_t address, void* data, u16_t length){
+	u8_t* bytes = (u8_t*) data;
+	u16_t i;
+	for (i = 0; i < length; i++){
+		bytes[i] = EEPROM_ReadByte(address + i);
+	}
+}
+
+void EEPROM_WriteBlock(u16_t address, const void* data, u16_t length){
+	const u8_t* bytes = (const u8_t*) data;
+	u16_t i;
+	for (i = 0; i < length; i++){
+		EEPROM_WriteByte(address + i, bytes[i]);
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * EEPROM.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef MCAL_EEPROM_EEPROM_H_
+#define MCAL_EEPROM_EEPROM_H_
+
+/* Registers Definition */
+#define EEARH		(*(volatile u8_t*)0x3F)
+#define EEARL		(*(volatile u8_t*)0x3E)
+#define EEDR		(*(volatile u8_t*)0x3D)
+#define EECR		(*(volatile u8_t*)0x3C)
+
+/* EECR */
+#define EERE		0
+#define EEWE		1
+#define EEMWE		2
+#define EERIE		3
+
+#define EEPROM_SIZE	1024		// ATmega32 has 1KB of EEPROM (addresses 0 to 1023).
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+u8_t EEPROM_ReadByte(u16_t address);
+void EEPROM_WriteByte(u16_t address, u8_t data);
+void EEPROM_ReadBlock(u16_t address, void* data, u16_t length);
+void EEPROM_WriteBlock(u16_t address, const void* data, u16_t length);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	EEPROM_ReadByte(u16_t address):
+ * 				@brief	Read a byte from the EEPROM.
+ *
+ * 				@details
+ * 						- Waits first if a write is still in progress.
+ *
+ * 				@param address: The address to read from (0 to 1023).
+ *
+ * 				@return u8_t
+ *
+ *	____________________________________________________________________________________
+
+ *	EEPROM_WriteByte(u16_t address, u8_t data):
+ * 				@brief	Write a byte into the EEPROM.
+ *
+ * 				@details
+ * 						- If the byte already has the same value, nothing is written to save the EEPROM from wearing (about 100,000 writes per cell).
+ * 						- A write takes about 8.5ms; the function waits only for the previous write, not for this one.
+ * 						- Interrupts are disabled for a few cycles, since EEWE must be set within 4 cycles after EEMWE.
+ *
+ * 				@param address: The address to write into (0 to 1023).
+ * 				@param data: The byte to be written.
+ *
+ *	____________________________________________________________________________________
+
+ *	EEPROM_ReadBlock(u16_t address, void* data, u16_t length):
+ * 				@brief	Read a number of bytes from the EEPROM.
+ *
+ * 				@param address: The address of the first byte.
+ * 				@param data: Pointer to where the bytes are copied.
+ * 				@param length: Number of bytes.
+ *
+ *	____________________________________________________________________________________
+
+ *	EEPROM_WriteBlock(u16_t address, const void* data, u16_t length):
+ * 				@brief	Write a number of bytes into the EEPROM.
+ *
+ * 				@param address: The address of the first byte.
+ * 				@param data: Pointer to the bytes to be written.
+ * 				@param length: Number of bytes.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* MCAL_EEPROM_EEPROM_H_ */
@@ -10,6 +10,7 @@
 
 /* Registers Definition */
 #define SREG		(*(volatile u8_t*)0x5F)
+#define SP			(*(volatile u16_t*)0x5D)		// SPH:SPL
 
 /* Flags Definition */
 #define I			7
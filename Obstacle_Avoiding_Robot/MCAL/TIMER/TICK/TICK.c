@@ -0,0 +1,102 @@
+/*
+ * TICK.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#include "../../../LIB/STD_TYPES.h"
+#include "../../../LIB/BIT_MATH.h"
+#include "../../INTERRUPT/INTERRUPT.h"
+#include "../TIMER.h"
+#include "TICK.h"
+
+/* Variables */
+volatile u32_t tick_counter = 0;
+u32_t tick_busy_counts = 0;			// TCNT0 counts spent from each overflow to the end of its callbacks.
+u8_t tick_running = 0;
+u8_t tick_callbacks_count = 0;
+
+/* Function Pointers */
+void (*tick_function_pointers[TIMER_TICK_MAXIMUM_CALLBACKS]) (void);
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void TIMER_TICK_Init(void){
+	if (tick_running){
+		return;
+	}
+	tick_running = 1;
+	TIMER_Timer0_OV_SetCallBack(TIMER_TICK_Handler);
+	TIMER_Timer0_OV_EnableInterrupt();
+	TIMER_Timer0_Init(TIMER0_NORMAL, TIMER0_PRESCALER_64);
+}
+
+u8_t TIMER_TICK_AddCallBack(void (*local_function_pointer) (void)){
+	u8_t i;
+	for (i = 0; i < tick_callbacks_count; i++){
+		if (tick_function_pointers[i] == local_function_pointer){
+			return 1;
+		}
+	}
+	if (tick_callbacks_count >= TIMER_TICK_MAXIMUM_CALLBACKS){
+		return 0;
+	}
+	tick_function_pointers[tick_callbacks_count] = local_function_pointer;
+	tick_callbacks_count++;			// The count is increased after the pointer is stored, so the ISR never calls an empty slot.
+	return 1;
+}
+
+u32_t TIMER_TICK_GetTicks(void){
+	u32_t ticks;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();		// A 32-bit read takes 4 instructions, so the ISR must not update it in between.
+	ticks = tick_counter;
+	SREG = sreg;
+	return ticks;
+}
+
+u32_t TIMER_TICK_GetCounts(void){
+	u32_t ticks;
+	u8_t counts;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	ticks = tick_counter;
+	counts = TCNT0;
+	/*
+	 * NOTE:
+	 * 		If TOV0 is set, Timer0 has overflowed but TIMER_TICK_Handler() has not run yet (interrupts are disabled).
+	 * 		If TCNT0 is still 255, it was read before the overflow happened, so only the other case is corrected.
+	 *
+	 */
+	if (GET_BIT(TIFR, TOV0) && counts != 255){
+		ticks++;
+	}
+	SREG = sreg;
+	return (ticks << 8) | counts;
+}
+
+void TIMER_TICK_Handler(void){
+	u8_t i;
+	tick_counter++;
+	for (i = 0; i < tick_callbacks_count; i++){
+		tick_function_pointers[i]();
+	}
+	// TCNT0 started from 0 at the overflow, so it is the time taken since then (including any ISR that delayed this one).
+	tick_busy_counts += TCNT0;
+	if (GET_BIT(TIFR, TOV0)){
+		tick_busy_counts += TIMER_TICK_COUNTS_PER_TICK;		// The callbacks took longer than a whole tick.
+	}
+}
+
+u32_t TIMER_TICK_GetBusyCounts(void){
+	u32_t counts;
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	counts = tick_busy_counts;
+	SREG = sreg;
+	return counts;
+}
@@ -0,0 +1,101 @@
+/*
+ * TICK.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Anas Dorgham
+ */
+
+#ifndef MCAL_TIMER_TICK_TICK_H_
+#define MCAL_TIMER_TICK_TICK_H_
+
+/*
+ * NOTE:
+ * 		The tick runs on Timer0 in normal mode with a prescaler of 64, so Timer0 overflows every 256 * 64 / 16MHz = 1.024ms.
+ * 		Timer0 is never stopped after TIMER_TICK_Init(), so any module can take timestamps from it (TIMER_TICK_GetCounts()).
+ * 		Timer0 has the lowest priority of the three timers, so the tick never delays the motors ISRs (Timer2 > Timer1 > Timer0).
+ *
+ */
+#define TIMER_TICK_PERIOD_US_			1024
+#define TIMER_TICK_COUNTS_PER_TICK		256			// TCNT0 counts per tick (8-bit counter).
+#define TIMER_TICK_CYCLES_PER_COUNT		64			// CPU cycles per TCNT0 count (prescaler).
+#define TIMER_TICK_MAXIMUM_CALLBACKS	10
+
+#define TIMER_TICK_MS_TO_TICKS(ms)		((u32_t) (((u32_t) (ms) * 1000UL) / TIMER_TICK_PERIOD_US_))
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void TIMER_TICK_Init(void);
+u8_t TIMER_TICK_AddCallBack(void (*local_function_pointer) (void));
+u32_t TIMER_TICK_GetTicks(void);
+u32_t TIMER_TICK_GetCounts(void);
+void TIMER_TICK_Handler(void);
+u32_t TIMER_TICK_GetBusyCounts(void);
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	TIMER_TICK_Init(void):
+ * 				@brief	Start the system tick.
+ *
+ * 				@details
+ * 						- Runs Timer0 in normal mode with a prescaler of 64 and enables its overflow interrupt.
+ * 						- Calling it again while the tick is running does nothing.
+ *
+ *	____________________________________________________________________________________
+
+ *	TIMER_TICK_AddCallBack(void (*local_function_pointer) (void)):
+ * 				@brief	Register a function to be called every tick (1.024ms) from the Timer0 overflow interrupt.
+ *
+ * 				@details
+ * 						- Callbacks run inside the ISR, so they must be short and must never delay.
+ * 						- Registering the same function twice has no effect.
+ *
+ * 				@param local_function_pointer: Pointer to the function that will be called every tick.
+ *
+ * 				@return 1 if the function is registered, 0 if the table (TIMER_TICK_MAXIMUM_CALLBACKS) is full.
+ *
+ *	____________________________________________________________________________________
+
+ *	TIMER_TICK_GetTicks(void):
+ * 				@brief	Get the number of ticks since TIMER_TICK_Init().
+ *
+ * 				@return u32_t (wraps after about 51 days).
+ *
+ *	____________________________________________________________________________________
+
+ *	TIMER_TICK_GetCounts(void):
+ * 				@brief	Get a fine timestamp in TCNT0 counts (4us each) since TIMER_TICK_Init().
+ *
+ * 				@details
+ * 						- It is safe to be called from an ISR; an overflow that is pending but not handled yet is taken into account.
+ * 						- The difference between two timestamps is a duration, even if the counter wrapped in between.
+ *
+ * 				@return u32_t
+ *
+ *	____________________________________________________________________________________
+
+ *	TIMER_TICK_Handler(void):
+ * 				@brief	Timer0 overflow callback which counts the tick and calls the registered callbacks.
+ *
+ *	____________________________________________________________________________________
+
+ *	TIMER_TICK_GetBusyCounts(void):
+ * 				@brief	Get the total time spent in the tick interrupt in TCNT0 counts (4us each) since TIMER_TICK_Init().
+ *
+ * 				@details
+ * 						- The difference between two readings divided by the TCNT0 counts in between is the load of the tick.
+ * 						- The time to enter the interrupt and any other ISR that delayed it are included.
+ *
+ * 				@return u32_t
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
+#endif /* MCAL_TIMER_TICK_TICK_H_ */
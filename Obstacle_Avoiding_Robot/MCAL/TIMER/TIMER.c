@@ -10,6 +10,7 @@
 #include "../../LIB/BIT_MATH.h"
 #include "../../LIB/PIN_CONFIG.h"
 #include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/INTERRUPT/INTERRUPT.h"
 #include "TIMER.h"
 
 
@@ -519,6 +520,9 @@ void TIMER_Timer1_Stop(void){
 
 void __vector_6(void) __attribute__ ((signal, used, externally_visible));
 void __vector_6 (void){
+	if (TIMER_PROFILE_LATENCY){
+		TIMER_Profile_Record(TIMER_PROFILE_TIMER1_CAPT, TCNT1L);		// TCNT1 restarts from 0 after reaching the top (ICR1).
+	}
 	if (Timer1_CAPT_function_pointer){		// Check if the function pointer is not NULL
 		Timer1_CAPT_function_pointer();		// Execute the function
 	}
@@ -526,6 +530,9 @@ void __vector_6 (void){
 
 void __vector_7(void) __attribute__ ((signal, used, externally_visible));
 void __vector_7 (void){
+	if (TIMER_PROFILE_LATENCY){
+		TIMER_Profile_Record(TIMER_PROFILE_TIMER1_COMPA, TCNT1L - OCR1AL);
+	}
 	if (Timer1_COMPA_function_pointer){		// Check if the function pointer is not NULL
 		Timer1_COMPA_function_pointer();	// Execute the function
 	}
@@ -716,6 +723,9 @@ void TIMER_Timer2_Stop(void){
 
 void __vector_4(void) __attribute__ ((signal, used, externally_visible));
 void __vector_4 (void){
+	if (TIMER_PROFILE_LATENCY){
+		TIMER_Profile_Record(TIMER_PROFILE_TIMER2_COMP, TCNT2 - OCR2);
+	}
 	if (Timer2_COMP_function_pointer){		// Check if the function pointer is not NULL
 		Timer2_COMP_function_pointer();		// Execute the function
 	}
@@ -723,6 +733,9 @@ void __vector_4 (void){
 
 void __vector_5(void) __attribute__ ((signal, used, externally_visible));
 void __vector_5 (void){
+	if (TIMER_PROFILE_LATENCY){
+		TIMER_Profile_Record(TIMER_PROFILE_TIMER2_OVF, TCNT2);
+	}
 	if (Timer2_OVF_function_pointer){		// Check if the function pointer is not NULL
 		Timer2_OVF_function_pointer();		// Execute the function
 	}
@@ -744,3 +757,53 @@ void TIMER_TIFR_ClearFlag(u8_t flag){
 }
 
 
+
+  /******************************************************************/
+ /******************** Timers Synchronization **********************/
+/******************************************************************/
+
+/* Variables */
+volatile u8_t timer_worst_latency[TIMER_PROFILED_ISRS];
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void TIMER_Timer1_Timer2_Synchronize(u16_t timer1_count, u8_t timer2_count){
+	u8_t sreg = SREG;
+	INTERRUPT_DisableGlobalInterrupt();
+	/*
+	 * NOTE:
+	 * 		After the prescalers are reset, the counters change only after one prescaler period (8 cycles for prescaler 8),
+	 * 		so the four registers are written by consecutive "out" instructions (one cycle each) to finish before that.
+	 * 		The I/O addresses are the memory addresses minus 0x20: SFIOR 0x30, TCNT2 0x24, TCNT1H 0x2D and TCNT1L 0x2C.
+	 * 		TCNT1H must be written before TCNT1L, since the high byte goes to a temporary register until the low byte is written.
+	 *
+	 */
+	__asm__ __volatile__ (
+			"out 0x30, %0" "\n\t"
+			"out 0x24, %1" "\n\t"
+			"out 0x2D, %2" "\n\t"
+			"out 0x2C, %3"
+			:: "r" ((u8_t) (SFIOR | (1 << PSR10) | (1 << PSR2))), "r" (timer2_count), "r" ((u8_t) (timer1_count >> 8)), "r" ((u8_t) timer1_count)
+			: "memory");
+	SREG = sreg;
+}
+
+void TIMER_Profile_Record(TIMER_profiled_isr isr, u8_t lateness){
+	if (lateness > timer_worst_latency[isr]){
+		timer_worst_latency[isr] = lateness;
+	}
+}
+
+u8_t TIMER_Profile_GetWorstLatency(TIMER_profiled_isr isr){
+	return timer_worst_latency[isr];
+}
+
+void TIMER_Profile_Reset(void){
+	u8_t i;
+	for (i = 0; i < TIMER_PROFILED_ISRS; i++){
+		timer_worst_latency[i] = 0;
+	}
+}
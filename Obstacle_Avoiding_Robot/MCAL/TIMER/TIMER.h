@@ -634,4 +634,87 @@ void TIMER_TIFR_ClearFlag(u8_t flag);
  */
 
 
+
+  /******************************************************************/
+ /******************** Timers Synchronization **********************/
+/******************************************************************/
+
+/* Special Function I/O Register */
+#define SFIOR		(*(volatile u8_t*)0x50)
+
+/* SFIOR */
+#define	PSR10	0		// Resets the prescaler of Timer0 and Timer1 (they share it).
+#define	PSR2	1		// Resets the prescaler of Timer2.
+
+/* ISR Latency Profiling */
+/*
+ * NOTE:
+ * 		Set TIMER_PROFILE_LATENCY to 1 to record how late the motor PWM interrupts run after their events (in timer counts).
+ * 		The lateness includes the fixed ISR prologue, so only the difference between two measurements matters.
+ * 		It is meaningful when Timer1 and Timer2 run as PWM with prescaler 64 (4us per count) and a top of 255.
+ * 		It is only the hook for measuring. The effect of the phase alignment (CAR_MOVEMENT_SetPhaseAlignment()) on these
+ * 		latencies has not been measured on the board yet, so no improvement is claimed.
+ *
+ */
+#define TIMER_PROFILE_LATENCY		0
+
+typedef enum{
+	TIMER_PROFILE_TIMER1_CAPT,
+	TIMER_PROFILE_TIMER1_COMPA,
+	TIMER_PROFILE_TIMER2_COMP,
+	TIMER_PROFILE_TIMER2_OVF,
+	TIMER_PROFILED_ISRS
+} TIMER_profiled_isr;
+
+
+
+/********************************\
+*********** Functions ************
+\********************************/
+
+void TIMER_Timer1_Timer2_Synchronize(u16_t timer1_count, u8_t timer2_count);
+void TIMER_Profile_Record(TIMER_profiled_isr isr, u8_t lateness);
+u8_t TIMER_Profile_GetWorstLatency(TIMER_profiled_isr isr);
+void TIMER_Profile_Reset(void);
+
+
+/*
+ * .-----------------------------.
+ * |Explanation of each function |
+ * '-----------------------------'
+
+ *	TIMER_Timer1_Timer2_Synchronize(u16_t timer1_count, u8_t timer2_count):
+ * 				@brief	Make Timer1 and Timer2 count together with a fixed phase between them.
+ *
+ * 				@details
+ * 						- Both timers must be started first with the same prescaler.
+ * 						- Both prescalers are reset by one write to SFIOR, then the counters are written before the next prescaler tick,
+ * 						  so from then on both counters change on the same clock cycle (prescaler 8 or more).
+ * 						- Timer0 shares the prescaler with Timer1, so one of its periods becomes up to one prescaler period longer.
+ *
+ * 				@param timer1_count: The value that TCNT1 starts from.
+ * 				@param timer2_count: The value that TCNT2 starts from.
+ *
+ *	____________________________________________________________________________________
+
+ *	TIMER_Profile_Record(TIMER_profiled_isr isr, u8_t lateness):
+ * 				@brief	Keep the worst lateness of an interrupt (called by the ISRs when TIMER_PROFILE_LATENCY is 1).
+ *
+ *	____________________________________________________________________________________
+
+ *	TIMER_Profile_GetWorstLatency(TIMER_profiled_isr isr):
+ * 				@brief	Get the worst lateness of an interrupt since the last reset.
+ *
+ * 				@return u8_t timer counts.
+ *
+ *	____________________________________________________________________________________
+
+ *	TIMER_Profile_Reset(void):
+ * 				@brief	Clear the recorded latencies.
+ *
+ *	____________________________________________________________________________________
+
+ */
+
+
 #endif /* MCAL_TIMER_TIMER_H_ */